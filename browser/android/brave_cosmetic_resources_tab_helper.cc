@@ -10,10 +10,7 @@
 #include <utility>
 
 #include "brave/browser/brave_browser_process_impl.h"
-#include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
-#include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
-#include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/browser/profiles/profile.h"
@@ -37,30 +34,12 @@ std::unique_ptr<base::ListValue> GetUrlCosmeticResourcesOnTaskRunner(
   auto result_list = std::make_unique<base::ListValue>();
 
   base::Optional<base::Value> resources = g_brave_browser_process->
-      ad_block_service()->UrlCosmeticResources(url);
+      ad_block_service()->GetMergedUrlCosmeticResources(url);
 
-  if (!resources || !resources->is_dict()) {
-    return result_list;
+  if (resources) {
+    result_list->Append(std::move(*resources));
   }
 
-  base::Optional<base::Value> regional_resources = g_brave_browser_process->
-      ad_block_regional_service_manager()->UrlCosmeticResources(url);
-
-  if (regional_resources && regional_resources->is_dict()) {
-    ::brave_shields::MergeResourcesInto(
-        std::move(*regional_resources), &*resources, /*force_hide=*/false);
-  }
-
-  base::Optional<base::Value> custom_resources = g_brave_browser_process->
-      ad_block_custom_filters_service()->UrlCosmeticResources(url);
-
-  if (custom_resources && custom_resources->is_dict()) {
-    ::brave_shields::MergeResourcesInto(
-        std::move(*custom_resources), &*resources, /*force_hide=*/true);
-  }
-
-  result_list->Append(std::move(*resources));
-
   return result_list;
 }
 
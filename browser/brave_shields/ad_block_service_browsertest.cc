@@ -4,7 +4,9 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "base/base64.h"
+#include "base/bind.h"
 #include "base/path_service.h"
+#include "base/run_loop.h"
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process_impl.h"
@@ -15,6 +17,7 @@
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/brave_shields/common/features.h"
@@ -32,6 +35,7 @@
 #include "net/dns/mock_host_resolver.h"
 
 using brave_shields::features::kBraveAdblockCosmeticFiltering;
+using brave_shields::features::kBraveNativeCosmeticFiltering;
 using content::BrowserThread;
 using extensions::ExtensionBrowserTest;
 
@@ -79,6 +83,9 @@ class AdBlockServiceTest : public ExtensionBrowserTest {
   void SetUpOnMainThread() override {
     ExtensionBrowserTest::SetUpOnMainThread();
     host_resolver()->AddRule("*", "127.0.0.1");
+    // Blocked counters are checked right after pages load.
+    brave_shields::BraveShieldsWebContentsObserver::
+        SetBlockedEventsFlushDelayForTesting(base::TimeDelta());
   }
 
   void SetUp() override {
@@ -239,6 +246,31 @@ class AdBlockServiceTest : public ExtensionBrowserTest {
     return true;
   }
 
+  // Returns the "generichide" flag of the merged url cosmetic resources for
+  // |url|, as computed (and cached) on the ad-block task runner.
+  bool GetMergedGenerichide(const GURL& url) {
+    brave_shields::AdBlockService* ad_block_service =
+        g_brave_browser_process->ad_block_service();
+    base::Optional<base::Value> resources;
+    base::RunLoop run_loop;
+    ad_block_service->GetTaskRunner()->PostTaskAndReply(
+        FROM_HERE,
+        base::BindOnce(
+            [](brave_shields::AdBlockService* ad_block_service,
+               const std::string& url,
+               base::Optional<base::Value>* resources) {
+              *resources =
+                  ad_block_service->GetMergedUrlCosmeticResources(url);
+            },
+            ad_block_service, url.spec(), &resources),
+        run_loop.QuitClosure());
+    run_loop.Run();
+    if (!resources)
+      return false;
+    base::Optional<bool> generichide = resources->FindBoolKey("generichide");
+    return generichide && *generichide;
+  }
+
   void WaitForAdBlockServiceThreads() {
     scoped_refptr<base::ThreadTestHelper> tr_helper(new base::ThreadTestHelper(
         g_brave_browser_process->local_data_files_service()->GetTaskRunner()));
@@ -865,6 +897,54 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringHide1pContent) {
                          "checkSelector('.fpsponsored', 'display', 'none')"));
 }
 
+class NativeCosmeticFilteringTest : public AdBlockServiceTest {
+ public:
+  NativeCosmeticFilteringTest() {
+    feature_list_.InitAndEnableFeature(kBraveNativeCosmeticFiltering);
+  }
+
+ private:
+  base::test::ScopedFeatureList feature_list_;
+};
+
+// Test simple cosmetic filtering applied by the renderer-side agent
+IN_PROC_BROWSER_TEST_F(NativeCosmeticFilteringTest, CosmeticFilteringSimple) {
+  UpdateAdBlockInstanceWithRules(
+      "b.com###ad-banner\n"
+      "##.ad");
+
+  GURL tab_url =
+      embedded_test_server()->GetURL("b.com", "/cosmetic_filtering.html");
+  ui_test_utils::NavigateToURL(browser(), tab_url);
+
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+
+  ASSERT_EQ(true,
+            EvalJs(contents, "checkSelector('#ad-banner', 'display', 'none')"));
+
+  ASSERT_EQ(true, EvalJs(contents,
+                         "checkSelector('.ad-banner', 'display', 'block')"));
+
+  ASSERT_EQ(true, EvalJs(contents, "checkSelector('.ad', 'display', 'none')"));
+}
+
+// Test the renderer-side agent ignores content determined to be 1st party
+IN_PROC_BROWSER_TEST_F(NativeCosmeticFilteringTest,
+                       CosmeticFilteringProtect1p) {
+  UpdateAdBlockInstanceWithRules("b.com##.fpsponsored\n");
+
+  GURL tab_url =
+      embedded_test_server()->GetURL("b.com", "/cosmetic_filtering.html");
+  ui_test_utils::NavigateToURL(browser(), tab_url);
+
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+
+  ASSERT_EQ(true, EvalJs(contents,
+                         "checkSelector('.fpsponsored', 'display', 'block')"));
+}
+
 // Test cosmetic filtering on elements added dynamically
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringDynamic) {
   UpdateAdBlockInstanceWithRules("##.blockme");
@@ -886,6 +966,28 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringDynamic) {
                          "checkSelector('.dontblockme', 'display', 'block')"));
 }
 
+// Test elements added dynamically are still filtered with the renderer-side
+// agent, which leaves DOM mutations to the extension content script
+IN_PROC_BROWSER_TEST_F(NativeCosmeticFilteringTest, CosmeticFilteringDynamic) {
+  UpdateAdBlockInstanceWithRules("##.blockme");
+
+  WaitForBraveExtensionShieldsDataReady();
+
+  GURL tab_url =
+      embedded_test_server()->GetURL("b.com", "/cosmetic_filtering.html");
+  ui_test_utils::NavigateToURL(browser(), tab_url);
+
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+
+  ASSERT_EQ(true, EvalJs(contents,
+                         "addElementsDynamically();\n"
+                         "checkSelector('.blockme', 'display', 'none')"));
+
+  ASSERT_EQ(true, EvalJs(contents,
+                         "checkSelector('.dontblockme', 'display', 'block')"));
+}
+
 // Test cosmetic filtering ignores generic cosmetic rules in the presence of a
 // `generichide` exception rule, both for elements added dynamically and
 // elements present at page load
@@ -914,6 +1016,25 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringGenerichide) {
                    "'display', 'inline')"));
 }
 
+// Test that a `generichide` exception scoped to a path doesn't leak to other
+// pages on the same host through the merged url cosmetic resources cache
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
+                       CosmeticFilteringGenerichidePathScoped) {
+  UpdateAdBlockInstanceWithRules(
+      "##.blockme\n"
+      "@@||b.com/excepted/$generichide");
+
+  const GURL excepted_url("https://b.com/excepted/page.html");
+  const GURL other_url("https://b.com/other/page.html");
+
+  // Query the excepted page first so that its result is in the cache.
+  EXPECT_TRUE(GetMergedGenerichide(excepted_url));
+  EXPECT_FALSE(GetMergedGenerichide(other_url));
+  // Cached results are still per url.
+  EXPECT_TRUE(GetMergedGenerichide(excepted_url));
+  EXPECT_FALSE(GetMergedGenerichide(other_url));
+}
+
 // Test custom style rules
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                        CosmeticFilteringCustomStyle) {
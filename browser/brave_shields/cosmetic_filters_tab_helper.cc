@@ -0,0 +1,158 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/brave_shields/cosmetic_filters_tab_helper.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/optional.h"
+#include "base/values.h"
+#include "brave/browser/brave_browser_process_impl.h"
+#include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/browser/profiles/profile.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/web_contents.h"
+
+namespace brave_shields {
+
+namespace {
+
+std::vector<std::string> ToStringVector(const base::Value* list) {
+  std::vector<std::string> result;
+  if (!list || !list->is_list())
+    return result;
+  for (const auto& item : list->GetList()) {
+    if (item.is_string())
+      result.push_back(item.GetString());
+  }
+  return result;
+}
+
+mojom::CosmeticResourcesPtr ToCosmeticResources(
+    base::Optional<base::Value> resources) {
+  if (!resources || !resources->is_dict())
+    return nullptr;
+
+  auto result = mojom::CosmeticResources::New();
+  result->hide_selectors =
+      ToStringVector(resources->FindListKey("hide_selectors"));
+  result->force_hide_selectors =
+      ToStringVector(resources->FindListKey("force_hide_selectors"));
+  result->exceptions = ToStringVector(resources->FindListKey("exceptions"));
+  if (const base::Value* style_selectors =
+          resources->FindDictKey("style_selectors")) {
+    for (const auto& item : style_selectors->DictItems()) {
+      result->style_selectors[item.first] = ToStringVector(&item.second);
+    }
+  }
+  if (const std::string* injected_script =
+          resources->FindStringKey("injected_script")) {
+    result->injected_script = *injected_script;
+  }
+  result->generichide =
+      resources->FindBoolKey("generichide").value_or(false);
+  return result;
+}
+
+base::Optional<base::Value> GetUrlCosmeticResourcesOnTaskRunner(
+    const std::string& url) {
+  return g_brave_browser_process->ad_block_service()->
+      GetMergedUrlCosmeticResources(url);
+}
+
+base::Value GetHiddenClassIdSelectorsOnTaskRunner(
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids,
+    const std::vector<std::string>& exceptions) {
+  return g_brave_browser_process->ad_block_service()->
+      GetMergedHiddenClassIdSelectors(classes, ids, exceptions);
+}
+
+void OnGetUrlCosmeticResources(
+    mojom::CosmeticFiltersResources::GetUrlCosmeticResourcesCallback callback,
+    bool hide_first_party_content,
+    base::Optional<base::Value> resources) {
+  mojom::CosmeticResourcesPtr result =
+      ToCosmeticResources(std::move(resources));
+  if (result)
+    result->hide_first_party_content = hide_first_party_content;
+  std::move(callback).Run(std::move(result));
+}
+
+void OnGetHiddenClassIdSelectors(
+    mojom::CosmeticFiltersResources::GetHiddenClassIdSelectorsCallback
+        callback,
+    base::Value selectors) {
+  // The merged list holds the default and regional selectors first, then the
+  // custom ones, which are always hidden.
+  const auto& lists = selectors.GetList();
+  std::move(callback).Run(
+      ToStringVector(lists.size() > 0 ? &lists[0] : nullptr),
+      ToStringVector(lists.size() > 1 ? &lists[1] : nullptr));
+}
+
+}  // namespace
+
+CosmeticFiltersTabHelper::CosmeticFiltersTabHelper(
+    content::WebContents* contents)
+    : WebContentsObserver(contents),
+      receivers_(contents, this) {}
+
+CosmeticFiltersTabHelper::~CosmeticFiltersTabHelper() {}
+
+HostContentSettingsMap* CosmeticFiltersTabHelper::GetSettingsMap() const {
+  return HostContentSettingsMapFactory::GetForProfile(
+      Profile::FromBrowserContext(web_contents()->GetBrowserContext()));
+}
+
+bool CosmeticFiltersTabHelper::ShouldDoCosmeticFiltering() const {
+  return ::brave_shields::ShouldDoCosmeticFiltering(
+      GetSettingsMap(), web_contents()->GetLastCommittedURL());
+}
+
+void CosmeticFiltersTabHelper::GetUrlCosmeticResources(
+    GetUrlCosmeticResourcesCallback callback) {
+  content::RenderFrameHost* render_frame_host =
+      receivers_.GetCurrentTargetFrame();
+  if (!ShouldDoCosmeticFiltering()) {
+    std::move(callback).Run(nullptr);
+    return;
+  }
+
+  g_brave_browser_process->ad_block_service()->GetTaskRunner()
+      ->PostTaskAndReplyWithResult(
+          FROM_HERE,
+          base::BindOnce(&GetUrlCosmeticResourcesOnTaskRunner,
+                         render_frame_host->GetLastCommittedURL().spec()),
+          base::BindOnce(&OnGetUrlCosmeticResources, std::move(callback),
+                         IsFirstPartyCosmeticFilteringEnabled(
+                             GetSettingsMap(),
+                             web_contents()->GetLastCommittedURL())));
+}
+
+void CosmeticFiltersTabHelper::GetHiddenClassIdSelectors(
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids,
+    const std::vector<std::string>& exceptions,
+    GetHiddenClassIdSelectorsCallback callback) {
+  if (!ShouldDoCosmeticFiltering()) {
+    std::move(callback).Run({}, {});
+    return;
+  }
+
+  g_brave_browser_process->ad_block_service()->GetTaskRunner()
+      ->PostTaskAndReplyWithResult(
+          FROM_HERE,
+          base::BindOnce(&GetHiddenClassIdSelectorsOnTaskRunner, classes, ids,
+                         exceptions),
+          base::BindOnce(&OnGetHiddenClassIdSelectors, std::move(callback)));
+}
+
+WEB_CONTENTS_USER_DATA_KEY_IMPL(CosmeticFiltersTabHelper)
+
+}  // namespace brave_shields
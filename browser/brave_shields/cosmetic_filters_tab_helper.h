@@ -0,0 +1,54 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_BRAVE_SHIELDS_COSMETIC_FILTERS_TAB_HELPER_H_
+#define BRAVE_BROWSER_BRAVE_SHIELDS_COSMETIC_FILTERS_TAB_HELPER_H_
+
+#include <string>
+#include <vector>
+
+#include "brave/components/brave_shields/common/cosmetic_filters.mojom.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "content/public/browser/web_contents_receiver_set.h"
+#include "content/public/browser/web_contents_user_data.h"
+
+class HostContentSettingsMap;
+
+namespace brave_shields {
+
+// Serves cosmetic filtering data to the renderer-side cosmetic filters agent
+// of every frame in the tab.
+class CosmeticFiltersTabHelper final
+    : public content::WebContentsObserver,
+      public content::WebContentsUserData<CosmeticFiltersTabHelper>,
+      public mojom::CosmeticFiltersResources {
+ public:
+  explicit CosmeticFiltersTabHelper(content::WebContents* contents);
+  ~CosmeticFiltersTabHelper() override;
+
+  // mojom::CosmeticFiltersResources
+  void GetUrlCosmeticResources(
+      GetUrlCosmeticResourcesCallback callback) override;
+  void GetHiddenClassIdSelectors(
+      const std::vector<std::string>& classes,
+      const std::vector<std::string>& ids,
+      const std::vector<std::string>& exceptions,
+      GetHiddenClassIdSelectorsCallback callback) override;
+
+  WEB_CONTENTS_USER_DATA_KEY_DECL();
+
+ private:
+  HostContentSettingsMap* GetSettingsMap() const;
+  bool ShouldDoCosmeticFiltering() const;
+
+  content::WebContentsFrameReceiverSet<mojom::CosmeticFiltersResources>
+      receivers_;
+
+  DISALLOW_COPY_AND_ASSIGN(CosmeticFiltersTabHelper);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_BROWSER_BRAVE_SHIELDS_COSMETIC_FILTERS_TAB_HELPER_H_
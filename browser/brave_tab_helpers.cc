@@ -7,6 +7,7 @@
 
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "brave/browser/brave_shields/cosmetic_filters_tab_helper.h"
 #include "brave/browser/brave_stats/brave_stats_tab_helper.h"
 #include "brave/browser/ephemeral_storage/ephemeral_storage_tab_helper.h"
 #include "brave/browser/farbling/farbling_tab_helper.h"
@@ -17,6 +18,7 @@
 #include "brave/components/brave_rewards/browser/buildflags/buildflags.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_shields/browser/buildflags/buildflags.h"  // For STP
+#include "brave/components/brave_shields/common/features.h"
 #include "brave/components/brave_wayback_machine/buildflags.h"
 #include "brave/components/greaselion/browser/buildflags/buildflags.h"
 #include "brave/components/ipfs/buildflags/buildflags.h"
@@ -84,10 +86,17 @@ void AttachTabHelpers(content::WebContents* web_contents) {
 #if defined(OS_ANDROID)
   DesktopModeTabHelper::CreateForWebContents(web_contents);
   BackgroundVideoPlaybackTabHelper::CreateForWebContents(web_contents);
+  // Native cosmetic filtering relies on the extension content script for DOM
+  // mutations, so Android always keeps the JS tab helper.
   BraveCosmeticResourcesTabHelper::CreateForWebContents(web_contents);
 #else
   // Add tab helpers here unless they are intended for android too
   BraveBookmarkTabHelper::CreateForWebContents(web_contents);
+  if (base::FeatureList::IsEnabled(
+          brave_shields::features::kBraveNativeCosmeticFiltering)) {
+    brave_shields::CosmeticFiltersTabHelper::CreateForWebContents(
+        web_contents);
+  }
 #endif
 
 #if BUILDFLAG(BRAVE_REWARDS_ENABLED)
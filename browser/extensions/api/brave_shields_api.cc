@@ -7,20 +7,18 @@
 
 #include <utility>
 
+#include "base/feature_list.h"
 #include "base/strings/string_number_conversions.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/browser/extensions/api/brave_action_api.h"
 #include "brave/browser/webcompat_reporter/webcompat_reporter_dialog.h"
 #include "brave/common/extensions/api/brave_shields.h"
-#include "brave/components/brave_shields/browser/ad_block_base_service.h"
-#include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
-#include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
-#include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/browser/brave_shields_p3a.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "brave/components/brave_shields/common/features.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/browser/extensions/api/tabs/tabs_constants.h"
@@ -67,27 +65,25 @@ BraveShieldsUrlCosmeticResourcesFunction::Run() {
 std::unique_ptr<base::ListValue> BraveShieldsUrlCosmeticResourcesFunction::
     GetUrlCosmeticResourcesOnTaskRunner(const std::string& url) {
   base::Optional<base::Value> resources = g_brave_browser_process->
-      ad_block_service()->UrlCosmeticResources(url);
+      ad_block_service()->GetMergedUrlCosmeticResources(url);
 
-  if (!resources || !resources->is_dict()) {
+  if (!resources) {
     return std::unique_ptr<base::ListValue>();
   }
 
-  base::Optional<base::Value> regional_resources = g_brave_browser_process->
-      ad_block_regional_service_manager()->UrlCosmeticResources(url);
-
-  if (regional_resources && regional_resources->is_dict()) {
-    ::brave_shields::MergeResourcesInto(
-        std::move(*regional_resources), &*resources, /*force_hide=*/false);
-  }
-
-  base::Optional<base::Value> custom_resources = g_brave_browser_process->
-      ad_block_custom_filters_service()->UrlCosmeticResources(url);
-
-  if (custom_resources && custom_resources->is_dict()) {
-    ::brave_shields::MergeResourcesInto(
-        std::move(*custom_resources), &*resources, /*force_hide=*/true);
+  // The renderer-side agent has already applied the url-level rules and the
+  // selectors for the classes and ids present at load, but it doesn't see DOM
+  // mutations. The content script only observes those, for which it needs the
+  // exceptions and the generichide flag.
+  const bool native_cosmetic_filtering = base::FeatureList::IsEnabled(
+      ::brave_shields::features::kBraveNativeCosmeticFiltering);
+  if (native_cosmetic_filtering) {
+    resources->SetKey("hide_selectors", base::ListValue());
+    resources->SetKey("force_hide_selectors", base::ListValue());
+    resources->SetKey("style_selectors", base::DictionaryValue());
+    resources->SetStringKey("injected_script", "");
   }
+  resources->SetBoolKey("observe_mutations_only", native_cosmetic_filtering);
 
   auto result_list = std::make_unique<base::ListValue>();
   result_list->Append(std::move(*resources));
@@ -126,38 +122,9 @@ std::unique_ptr<base::ListValue> BraveShieldsHiddenClassIdSelectorsFunction::
         const std::vector<std::string>& classes,
         const std::vector<std::string>& ids,
         const std::vector<std::string>& exceptions) {
-  base::Optional<base::Value> hide_selectors = g_brave_browser_process->
-      ad_block_service()->HiddenClassIdSelectors(classes, ids, exceptions);
-
-  base::Optional<base::Value> regional_selectors = g_brave_browser_process->
-      ad_block_regional_service_manager()->
-          HiddenClassIdSelectors(classes, ids, exceptions);
-
-  base::Optional<base::Value> custom_selectors = g_brave_browser_process->
-      ad_block_custom_filters_service()->
-          HiddenClassIdSelectors(classes, ids, exceptions);
-
-  if (hide_selectors && hide_selectors->is_list()) {
-    if (regional_selectors && regional_selectors->is_list()) {
-      for (auto i = regional_selectors->GetList().begin();
-              i < regional_selectors->GetList().end();
-              i++) {
-        hide_selectors->Append(std::move(*i));
-      }
-    }
-  } else {
-    hide_selectors = std::move(regional_selectors);
-  }
-
-  auto result_list = std::make_unique<base::ListValue>();
-  if (hide_selectors && hide_selectors->is_list()) {
-    result_list->Append(std::move(*hide_selectors));
-  }
-  if (custom_selectors && custom_selectors->is_list()) {
-    result_list->Append(std::move(*custom_selectors));
-  }
-
-  return result_list;
+  return base::ListValue::From(base::Value::ToUniquePtrValue(
+      g_brave_browser_process->ad_block_service()->
+          GetMergedHiddenClassIdSelectors(classes, ids, exceptions)));
 }
 
 void BraveShieldsHiddenClassIdSelectorsFunction::
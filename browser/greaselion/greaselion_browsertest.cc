@@ -22,6 +22,7 @@
 #include "chrome/test/base/ui_test_utils.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
+#include "extensions/browser/extension_registry.h"
 #include "net/dns/mock_host_resolver.h"
 #include "ui/base/ui_base_switches.h"
 
@@ -353,6 +354,33 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, IsGreaselionExtension) {
   EXPECT_TRUE(greaselion_service->IsGreaselionExtension(extension_ids[0]));
 }
 
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
+                       UpdateKeepsUnchangedExtensionsInstalled) {
+  ASSERT_TRUE(InstallMockExtension());
+
+  GreaselionService* greaselion_service =
+      GreaselionServiceFactory::GetForBrowserContext(profile());
+  ASSERT_TRUE(greaselion_service);
+  auto extension_ids = greaselion_service->GetExtensionIdsForTesting();
+  ASSERT_GT(extension_ids.size(), 0UL);
+
+  extensions::ExtensionRegistry* registry =
+      extensions::ExtensionRegistry::Get(profile());
+  std::vector<const extensions::Extension*> extensions;
+  for (const auto& id : extension_ids)
+    extensions.push_back(registry->enabled_extensions().GetByID(id));
+
+  // Nothing changed, so the same extensions should still be loaded rather
+  // than being unloaded and converted again.
+  greaselion_service->UpdateInstalledExtensions();
+  GreaselionServiceWaiter(greaselion_service).Wait();
+  EXPECT_EQ(extension_ids, greaselion_service->GetExtensionIdsForTesting());
+  for (size_t i = 0; i < extension_ids.size(); ++i) {
+    EXPECT_EQ(extensions[i],
+              registry->enabled_extensions().GetByID(extension_ids[i]));
+  }
+}
+
 IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, IsNotGreaselionExtension) {
   ASSERT_TRUE(InstallMockExtension());
 
@@ -5,14 +5,17 @@
 
 #include "brave/browser/net/brave_common_static_redirect_network_delegate_helper.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
+#include "brave/browser/net/url_pattern_host_index.h"
 #include "brave/common/network_constants.h"
 #include "brave/components/brave_component_updater/browser/features.h"
 #include "brave/components/brave_component_updater/browser/switches.h"
@@ -47,11 +50,8 @@ std::string GetUpdateURLHost() {
   return UPDATER_DEV_ENDPOINT;
 }
 
-// Update server checks happen from the profile context for admin policy
-// installed extensions. Update server checks happen from the system context for
-// normal update operations.
-bool IsUpdaterURL(const GURL& gurl) {
-  static std::vector<URLPattern> updater_patterns(
+const std::vector<URLPattern>& GetUpdaterPatterns() {
+  static const base::NoDestructor<std::vector<URLPattern>> updater_patterns(
       {URLPattern(URLPattern::SCHEME_HTTPS,
                   std::string(component_updater::kUpdaterJSONDefaultUrl) + "*"),
        URLPattern(
@@ -63,9 +63,17 @@ bool IsUpdaterURL(const GURL& gurl) {
            std::string(extension_urls::kChromeWebstoreUpdateURL) + "*")
 #endif
   });
+  return *updater_patterns;
+}
+
+// Update server checks happen from the profile context for admin policy
+// installed extensions. Update server checks happen from the system context for
+// normal update operations.
+bool IsUpdaterURL(const GURL& gurl) {
+  const std::vector<URLPattern>& updater_patterns = GetUpdaterPatterns();
   return std::any_of(
       updater_patterns.begin(), updater_patterns.end(),
-      [&gurl](URLPattern pattern) { return pattern.MatchesURL(gurl); });
+      [&gurl](const URLPattern& pattern) { return pattern.MatchesURL(gurl); });
 }
 
 bool RewriteBugReportingURL(const GURL& request_url, GURL* new_url) {
@@ -124,6 +132,19 @@ int OnBeforeURLRequest_CommonStaticRedirectWorkForGURL(
       URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
       "*://bugs.chromium.org/p/chromium/issues/entry?*");
 
+  // Skip the pattern checks below for requests to any other host.
+  static const base::NoDestructor<URLPatternHostIndex> host_index([]() {
+    std::vector<const URLPattern*> patterns(
+        {&chromecast_pattern, &clients4_pattern, &bugsChromium_pattern});
+    for (const auto& pattern : GetUpdaterPatterns()) {
+      patterns.push_back(&pattern);
+    }
+    return patterns;
+  }());
+  if (!host_index->MightMatch(request_url)) {
+    return net::OK;
+  }
+
   if (IsUpdaterURL(request_url)) {
     auto update_host = GetUpdateURLHost();
     if (!update_host.empty()) {
@@ -126,15 +126,14 @@ BraveProxyingURLLoaderFactory::InProgressRequest::~InProgressRequest() {
 }
 
 void BraveProxyingURLLoaderFactory::InProgressRequest::Restart() {
-  UpdateRequestInfo();
+  // The context is created once and then updated in place at each stage,
+  // which keeps the redirect state across redirects.
+  ctx_ = brave::BraveRequestInfo::MakeCTX(request_, render_process_id_,
+                                          frame_tree_node_id_, request_id_,
+                                          browser_context_);
   RestartInternal();
 }
 
-void BraveProxyingURLLoaderFactory::InProgressRequest::UpdateRequestInfo() {
-  // TODO(iefremov): Update |ctx_| here and get rid of multiple spots where
-  // it is refilled.
-}
-
 void BraveProxyingURLLoaderFactory::InProgressRequest::RestartInternal() {
   request_completed_ = false;
   start_time_ = base::TimeTicks::Now();
@@ -143,9 +142,7 @@ void BraveProxyingURLLoaderFactory::InProgressRequest::RestartInternal() {
       base::BindRepeating(&InProgressRequest::ContinueToBeforeSendHeaders,
                           weak_factory_.GetWeakPtr());
   redirect_url_ = GURL();
-  ctx_ = brave::BraveRequestInfo::MakeCTX(request_, render_process_id_,
-                                          frame_tree_node_id_, request_id_,
-                                          browser_context_, ctx_);
+  brave::BraveRequestInfo::UpdateCTX(request_, browser_context_, ctx_.get());
   int result = factory_->request_handler_->OnBeforeURLRequest(
       ctx_, continuation, &redirect_url_);
 
@@ -185,8 +182,6 @@ void BraveProxyingURLLoaderFactory::InProgressRequest::FollowRedirect(
     request_.headers.RemoveHeader(header);
   request_.headers.MergeFrom(modified_headers);
 
-  UpdateRequestInfo();
-
   if (target_loader_.is_bound()) {
     auto params = std::make_unique<FollowRedirectParams>();
     params->removed_headers = removed_headers;
@@ -392,9 +387,8 @@ void BraveProxyingURLLoaderFactory::InProgressRequest::
     auto continuation = base::BindRepeating(
         &InProgressRequest::ContinueToSendHeaders, weak_factory_.GetWeakPtr());
 
-    ctx_ = brave::BraveRequestInfo::MakeCTX(request_, render_process_id_,
-                                            frame_tree_node_id_, request_id_,
-                                            browser_context_, ctx_);
+    brave::BraveRequestInfo::UpdateCTX(request_, browser_context_,
+                                       ctx_.get());
     int result = factory_->request_handler_->OnBeforeStartTransaction(
         ctx_, continuation, &request_.headers);
 
@@ -572,9 +566,8 @@ void BraveProxyingURLLoaderFactory::InProgressRequest::
   net::CompletionRepeatingCallback copyable_callback =
       base::AdaptCallbackForRepeating(std::move(continuation));
   if (request_.url.SchemeIsHTTPOrHTTPS()) {
-    ctx_ = brave::BraveRequestInfo::MakeCTX(request_, render_process_id_,
-                                            frame_tree_node_id_, request_id_,
-                                            browser_context_, ctx_);
+    brave::BraveRequestInfo::UpdateCTX(request_, browser_context_,
+                                       ctx_.get());
     int result = factory_->request_handler_->OnHeadersReceived(
         ctx_, copyable_callback, current_response_->headers.get(),
         &override_headers_, &redirect_url_);
@@ -95,8 +95,6 @@ class BraveProxyingURLLoaderFactory
     void OnComplete(const network::URLLoaderCompletionStatus& status) override;
 
    private:
-    // These two methods combined form the implementation of Restart().
-    void UpdateRequestInfo();
     void RestartInternal();
 
     void ContinueToBeforeSendHeaders(int error_code);
@@ -87,7 +87,7 @@ void BraveProxyingWebSocket::Start() {
 
   ctx_ = brave::BraveRequestInfo::MakeCTX(request_, process_id_,
                                           frame_tree_node_id_, request_id_,
-                                          browser_context_, ctx_);
+                                          browser_context_);
   int result = request_handler_->OnBeforeURLRequest(
       ctx_, continuation, &redirect_url_);
   // TODO(bridiver) - need to handle general case for redirect_url
@@ -157,9 +157,7 @@ void BraveProxyingWebSocket::ContinueToHeadersReceived() {
   auto continuation = base::BindRepeating(
       &BraveProxyingWebSocket::OnHeadersReceivedComplete,
       weak_factory_.GetWeakPtr());
-  ctx_ = brave::BraveRequestInfo::MakeCTX(request_, process_id_,
-                                          frame_tree_node_id_, request_id_,
-                                          browser_context_, ctx_);
+  brave::BraveRequestInfo::UpdateCTX(request_, browser_context_, ctx_.get());
   int result = request_handler_->OnHeadersReceived(
       ctx_, continuation, response_.headers.get(),
       &override_headers_, &redirect_url_);
@@ -267,9 +265,7 @@ void BraveProxyingWebSocket::OnBeforeSendHeadersCompleteFromProxy(
       &BraveProxyingWebSocket::OnBeforeSendHeadersComplete,
       weak_factory_.GetWeakPtr());
 
-  ctx_ = brave::BraveRequestInfo::MakeCTX(request_, process_id_,
-                                          frame_tree_node_id_, request_id_,
-                                          browser_context_, ctx_);
+  brave::BraveRequestInfo::UpdateCTX(request_, browser_context_, ctx_.get());
   int result = request_handler_->OnBeforeStartTransaction(
       ctx_, continuation, &request_.headers);
 
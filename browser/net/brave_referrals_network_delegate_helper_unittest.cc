@@ -11,6 +11,7 @@
 #include "base/json/json_reader.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
 #include "net/base/net_errors.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "url/gurl.h"
@@ -61,10 +62,11 @@ TEST(BraveReferralsNetworkDelegateHelperTest, ReplaceHeadersForMatchingDomain) {
 
   const base::ListValue* referral_headers_list = nullptr;
   referral_headers.value->GetAsList(&referral_headers_list);
+  const brave::ReferralHeadersMatcher matcher(*referral_headers_list);
 
   net::HttpRequestHeaders headers;
   auto request_info = std::make_shared<brave::BraveRequestInfo>(url);
-  request_info->referral_headers_list = referral_headers_list;
+  request_info->referral_headers_matcher = &matcher;
 
   int rc = brave::OnBeforeStartTransaction_ReferralsWork(
       &headers, brave::ResponseCallback(), request_info);
@@ -90,13 +92,58 @@ TEST(BraveReferralsNetworkDelegateHelperTest,
 
   const base::ListValue* referral_headers_list = nullptr;
   referral_headers.value->GetAsList(&referral_headers_list);
+  const brave::ReferralHeadersMatcher matcher(*referral_headers_list);
 
   net::HttpRequestHeaders headers;
   auto request_info = std::make_shared<brave::BraveRequestInfo>(GURL());
-  request_info->referral_headers_list = referral_headers_list;
+  request_info->referral_headers_matcher = &matcher;
   int rc = brave::OnBeforeStartTransaction_ReferralsWork(
       &headers, brave::ResponseCallback(), request_info);
 
   EXPECT_FALSE(headers.HasHeader("X-Brave-Partner"));
   EXPECT_EQ(rc, net::OK);
 }
+
+TEST(BraveReferralsNetworkDelegateHelperTest,
+     ReplaceHeadersForMatchingSubdomain) {
+  base::JSONReader::ValueWithError referral_headers =
+      base::JSONReader::ReadAndReturnValueWithError(kTestReferralHeaders);
+  ASSERT_TRUE(referral_headers.value);
+  ASSERT_TRUE(referral_headers.value->is_list());
+
+  const base::ListValue* referral_headers_list = nullptr;
+  referral_headers.value->GetAsList(&referral_headers_list);
+  const brave::ReferralHeadersMatcher matcher(*referral_headers_list);
+
+  const GURL matching_urls[] = {
+      GURL("http://popcrush.com/"),
+      GURL("https://news.XXLMAG.com./path"),
+      GURL("https://a.b.tasteofcountry.com/"),
+  };
+  for (const auto& url : matching_urls) {
+    net::HttpRequestHeaders headers;
+    auto request_info = std::make_shared<brave::BraveRequestInfo>(url);
+    request_info->referral_headers_matcher = &matcher;
+    int rc = brave::OnBeforeStartTransaction_ReferralsWork(
+        &headers, brave::ResponseCallback(), request_info);
+
+    std::string partner_header;
+    EXPECT_TRUE(headers.GetHeader("X-Brave-Partner", &partner_header)) << url;
+    EXPECT_EQ(partner_header, "townsquare");
+    EXPECT_EQ(rc, net::OK);
+  }
+
+  const GURL non_matching_urls[] = {
+      GURL("https://notpopcrush.com/"),
+      GURL("https://popcrush.com.evil.com/"),
+      GURL("ftp://popcrush.com/"),
+  };
+  for (const auto& url : non_matching_urls) {
+    net::HttpRequestHeaders headers;
+    auto request_info = std::make_shared<brave::BraveRequestInfo>(url);
+    request_info->referral_headers_matcher = &matcher;
+    brave::OnBeforeStartTransaction_ReferralsWork(
+        &headers, brave::ResponseCallback(), request_info);
+    EXPECT_FALSE(headers.HasHeader("X-Brave-Partner")) << url;
+  }
+}
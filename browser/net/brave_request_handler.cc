@@ -33,6 +33,7 @@
 
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
 #include "brave/browser/net/brave_referrals_network_delegate_helper.h"
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
 #endif
 
 #if BUILDFLAG(BRAVE_REWARDS_ENABLED)
@@ -134,10 +135,13 @@ void BraveRequestHandler::InitPrefChangeRegistrar() {
 
 void BraveRequestHandler::OnReferralHeadersChanged() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+#if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
   if (const base::ListValue* referral_headers =
           g_browser_process->local_state()->GetList(kReferralHeaders)) {
-    referral_headers_list_.reset(referral_headers->DeepCopy());
+    referral_headers_matcher_ =
+        std::make_unique<brave::ReferralHeadersMatcher>(*referral_headers);
   }
+#endif
 }
 
 bool BraveRequestHandler::IsRequestIdentifierValid(
@@ -169,7 +173,9 @@ int BraveRequestHandler::OnBeforeStartTransaction(
   }
   ctx->event_type = brave::kOnBeforeStartTransaction;
   ctx->headers = headers;
-  ctx->referral_headers_list = referral_headers_list_.get();
+#if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
+  ctx->referral_headers_matcher = referral_headers_matcher_.get();
+#endif
   callbacks_[ctx->request_identifier] = std::move(callback);
   RunNextCallback(ctx);
   return net::ERR_IO_PENDING;
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "brave/browser/net/url_context.h"
+#include "brave/components/brave_referrals/buildflags/buildflags.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/completion_once_callback.h"
 
@@ -59,12 +60,16 @@ class BraveRequestHandler {
       before_start_transaction_callbacks_;
   std::vector<brave::OnHeadersReceivedCallback> headers_received_callbacks_;
 
+#if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
   // TODO(iefremov): actually, we don't have to keep the list here, since
   // it is global for the whole browser and could live a singletonce in the
   // rewards service. Eliminating this will also help to avoid using
   // PrefChangeRegistrar and corresponding |base::Unretained| usages, that are
   // illegal.
-  std::unique_ptr<base::ListValue> referral_headers_list_;
+  // Compiled from the referral headers pref whenever it changes, so that
+  // requests only pay for a host lookup.
+  std::unique_ptr<brave::ReferralHeadersMatcher> referral_headers_matcher_;
+#endif
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
   std::unique_ptr<PrefChangeRegistrar, content::BrowserThread::DeleteOnUIThread>
       pref_change_registrar_;
@@ -7,30 +7,44 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
-#include "base/lazy_instance.h"
+#include "base/containers/flat_set.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/no_destructor.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/shield_exceptions.h"
 #include "brave/common/url_constants.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "content/public/browser/browser_thread.h"
 #include "content/public/common/referrer.h"
 #include "extensions/common/url_pattern.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "net/url_request/url_request.h"
 #include "third_party/blink/public/common/loader/network_utils.h"
 #include "third_party/blink/public/common/loader/referrer_utils.h"
-#include "third_party/re2/src/re2/re2.h"
 
 namespace brave {
 
 namespace {
 
-const std::string& GetQueryStringTrackers() {
-  static const base::NoDestructor<std::string> trackers(base::JoinString(
+// Orders tracker names case-insensitively so that lookups need neither a
+// lowercased copy of the parameter name nor a regex.
+struct CaseInsensitiveLess {
+  using is_transparent = void;
+
+  bool operator()(base::StringPiece lhs, base::StringPiece rhs) const {
+    return base::CompareCaseInsensitiveASCII(lhs, rhs) < 0;
+  }
+};
+
+using QueryStringTrackers = base::flat_set<std::string, CaseInsensitiveLess>;
+
+const QueryStringTrackers& GetQueryStringTrackers() {
+  static const base::NoDestructor<QueryStringTrackers> trackers(
       std::vector<std::string>(
           {// https://github.com/brave/brave-browser/issues/4239
            "fbclid", "gclid", "msclkid", "mc_eid",
@@ -43,40 +57,73 @@ const std::string& GetQueryStringTrackers() {
            // https://github.com/brave/brave-browser/issues/11578
            "yclid",
            // https://github.com/brave/brave-browser/issues/9019
-           "_hsenc", "__hssc", "__hstc", "__hsfp", "hsCtaTracking"}),
-      "|"));
+           "_hsenc", "__hssc", "__hstc", "__hsfp", "hsCtaTracking"}));
   return *trackers;
 }
 
-// From src/components/autofill/content/renderer/page_passwords_analyser.cc
-// and password_form_conversion_utils.cc:
-#define DECLARE_LAZY_MATCHER(NAME, PATTERN)                                   \
-  struct LabelPatternLazyInstanceTraits_##NAME                                \
-      : public base::internal::DestructorAtExitLazyInstanceTraits<re2::RE2> { \
-    static re2::RE2* New(void* instance) {                                    \
-      re2::RE2::Options options;                                              \
-      options.set_case_sensitive(false);                                      \
-      re2::RE2* matcher = new (instance) re2::RE2(PATTERN, options);          \
-      DCHECK(matcher->ok());                                                  \
-      return matcher;                                                         \
-    }                                                                         \
-  };                                                                          \
-  base::LazyInstance<re2::RE2, LabelPatternLazyInstanceTraits_##NAME> NAME =  \
-      LAZY_INSTANCE_INITIALIZER
-
-// e.g. "?fbclid=1234"
-DECLARE_LAZY_MATCHER(tracker_only_matcher,
-                     "^(" + GetQueryStringTrackers() + ")=[^&]+$");
-
-// e.g. "?fbclid=1234&foo=1"
-DECLARE_LAZY_MATCHER(tracker_first_matcher,
-                     "^(" + GetQueryStringTrackers() + ")=[^&]+&");
-
-// e.g. "?foo=1&fbclid=1234" or "?foo=1&fbclid=1234&bar=2"
-DECLARE_LAZY_MATCHER(tracker_appended_matcher,
-                     "&(" + GetQueryStringTrackers() + ")=[^&]+");
-
-#undef DECLARE_LAZY_MATCHER
+// Tracker names set through SetExtraQueryStringTrackers(). Only accessed on
+// the UI thread, and replaced as a whole.
+QueryStringTrackers* GetExtraQueryStringTrackers() {
+  static base::NoDestructor<QueryStringTrackers> trackers;
+  return trackers.get();
+}
+
+// A parameter is a tracker if its name is in the tracker list and it
+// carries a non-empty value, e.g. "fbclid=1234" but not "fbclid" or
+// "fbclid=".
+bool IsQueryStringTracker(base::StringPiece param) {
+  const size_t separator = param.find('=');
+  if (separator == base::StringPiece::npos || separator + 1 == param.size()) {
+    return false;
+  }
+
+  const base::StringPiece name = param.substr(0, separator);
+  const QueryStringTrackers& trackers = GetQueryStringTrackers();
+  if (trackers.find(name) != trackers.end())
+    return true;
+  const QueryStringTrackers* extra_trackers = GetExtraQueryStringTrackers();
+  return extra_trackers->find(name) != extra_trackers->end();
+}
+
+// Walks the "&"-separated parameters of |query| once and drops trackers.
+// |new_query| is only written, and returns true, if something was removed.
+// Empty parameters are preserved, so "a&&fbclid=1" becomes "a&".
+bool StripQueryStringTrackers(base::StringPiece query,
+                              std::string* new_query) {
+  DCHECK(new_query);
+
+  bool modified = false;
+  size_t kept_count = 0;
+  size_t start = 0;
+  while (start <= query.size()) {
+    size_t end = query.find('&', start);
+    if (end == base::StringPiece::npos) {
+      end = query.size();
+    }
+
+    const base::StringPiece param = query.substr(start, end - start);
+    if (IsQueryStringTracker(param)) {
+      if (!modified) {
+        modified = true;
+        // Everything before this parameter is kept as is, minus the
+        // trailing separator.
+        new_query->assign(query.data(), start > 0 ? start - 1 : 0);
+      }
+    } else {
+      if (modified) {
+        if (kept_count > 0) {
+          new_query->push_back('&');
+        }
+        param.AppendToString(new_query);
+      }
+      ++kept_count;
+    }
+
+    start = end + 1;
+  }
+
+  return modified;
+}
 
 void ApplyPotentialQueryStringFilter(std::shared_ptr<BraveRequestInfo> ctx) {
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.SiteHacks.QueryFilter");
@@ -102,23 +149,19 @@ void ApplyPotentialQueryStringFilter(std::shared_ptr<BraveRequestInfo> ctx) {
     return;
   }
 
-  std::string new_query = ctx->request_url.query();
-  // Note: the ordering of these replacements is important.
-  const int replacement_count =
-      re2::RE2::GlobalReplace(&new_query, tracker_appended_matcher.Get(), "") +
-      re2::RE2::GlobalReplace(&new_query, tracker_first_matcher.Get(), "") +
-      re2::RE2::GlobalReplace(&new_query, tracker_only_matcher.Get(), "");
-
-  if (replacement_count > 0) {
-    url::Replacements<char> replacements;
-    if (new_query.empty()) {
-      replacements.ClearQuery();
-    } else {
-      replacements.SetQuery(new_query.c_str(),
-                            url::Component(0, new_query.size()));
-    }
-    ctx->new_url_spec = ctx->request_url.ReplaceComponents(replacements).spec();
+  std::string new_query;
+  if (!StripQueryStringTrackers(ctx->request_url.query_piece(), &new_query)) {
+    return;
   }
+
+  url::Replacements<char> replacements;
+  if (new_query.empty()) {
+    replacements.ClearQuery();
+  } else {
+    replacements.SetQuery(new_query.c_str(),
+                          url::Component(0, new_query.size()));
+  }
+  ctx->new_url_spec = ctx->request_url.ReplaceComponents(replacements).spec();
 }
 
 bool ApplyPotentialReferrerBlock(std::shared_ptr<BraveRequestInfo> ctx) {
@@ -146,6 +189,13 @@ bool ApplyPotentialReferrerBlock(std::shared_ptr<BraveRequestInfo> ctx) {
 
 }  // namespace
 
+void SetExtraQueryStringTrackers(std::vector<std::string> trackers) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  // Sort the new list up front, then swap it in.
+  QueryStringTrackers new_trackers(std::move(trackers));
+  GetExtraQueryStringTrackers()->swap(new_trackers);
+}
+
 int OnBeforeURLRequest_SiteHacksWork(const ResponseCallback& next_callback,
                                      std::shared_ptr<BraveRequestInfo> ctx) {
   ApplyPotentialReferrerBlock(ctx);
@@ -7,6 +7,8 @@
 #define BRAVE_BROWSER_NET_BRAVE_SITE_HACKS_NETWORK_DELEGATE_HELPER_H_
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "brave/browser/net/url_context.h"
 
@@ -16,6 +18,11 @@ class URLRequest;
 
 namespace brave {
 
+// Replaces the query string parameters that are stripped from cross-site
+// requests on top of the built-in list, e.g. with names delivered by a
+// component. Must be called on the UI thread.
+void SetExtraQueryStringTrackers(std::vector<std::string> trackers);
+
 int OnBeforeURLRequest_SiteHacksWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx);
@@ -12,6 +12,7 @@
 
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
+#include "content/public/test/browser_task_environment.h"
 #include "net/base/net_errors.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -297,3 +298,40 @@ TEST(BraveSiteHacksNetworkDelegateHelperTest, QueryStringFiltered) {
     EXPECT_EQ(brave_request_info->new_url_spec, "https://example.com/");
   }
 }
+
+TEST(BraveSiteHacksNetworkDelegateHelperTest, QueryStringTrackersIgnoreCase) {
+  content::BrowserTaskEnvironment task_environment;
+
+  const GURL url("https://example.com/?foo=1&FBCLID=2&HsCtaTracking=3");
+  auto brave_request_info = std::make_shared<brave::BraveRequestInfo>(url);
+  brave_request_info->initiator_url =
+      GURL("https://example.net");  // cross-site
+  int rc = brave::OnBeforeURLRequest_SiteHacksWork(ResponseCallback(),
+                                                   brave_request_info);
+  EXPECT_EQ(rc, net::OK);
+  EXPECT_EQ(brave_request_info->new_url_spec, "https://example.com/?foo=1");
+}
+
+TEST(BraveSiteHacksNetworkDelegateHelperTest, ExtraQueryStringTrackers) {
+  content::BrowserTaskEnvironment task_environment;
+
+  const GURL url("https://example.com/?foo=1&brave_test_clid=1&FBCLID=2");
+  auto filter = [&url]() {
+    auto brave_request_info = std::make_shared<brave::BraveRequestInfo>(url);
+    brave_request_info->initiator_url =
+        GURL("https://example.net");  // cross-site
+    int rc = brave::OnBeforeURLRequest_SiteHacksWork(ResponseCallback(),
+                                                     brave_request_info);
+    EXPECT_EQ(rc, net::OK);
+    return brave_request_info->new_url_spec;
+  };
+
+  EXPECT_EQ(filter(), "https://example.com/?foo=1&brave_test_clid=1");
+
+  brave::SetExtraQueryStringTrackers({"brave_test_clid"});
+  EXPECT_EQ(filter(), "https://example.com/?foo=1");
+
+  // Replacing the extra list drops the previous names.
+  brave::SetExtraQueryStringTrackers({});
+  EXPECT_EQ(filter(), "https://example.com/?foo=1&brave_test_clid=1");
+}
@@ -17,6 +17,8 @@
 #include "chrome/browser/profiles/profile.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/isolation_info.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/resource_request_body.h"
 
 #if BUILDFLAG(IPFS_ENABLED)
 #include "brave/components/ipfs/pref_names.h"
@@ -27,14 +29,18 @@
 
 namespace brave {
 
-namespace {
+BraveRequestInfo::BraveRequestInfo() = default;
+
+BraveRequestInfo::BraveRequestInfo(const GURL& url) : request_url(url) {}
 
-std::string GetUploadData(const network::ResourceRequest& request) {
+BraveRequestInfo::~BraveRequestInfo() = default;
+
+std::string BraveRequestInfo::GetUploadData() const {
   std::string upload_data;
-  if (!request.request_body) {
+  if (!request_body) {
     return {};
   }
-  const auto* elements = request.request_body->elements();
+  const auto* elements = request_body->elements();
   for (const network::DataElement& element : *elements) {
     if (element.type() == network::mojom::DataElementType::kBytes) {
       upload_data.append(element.bytes(), element.length());
@@ -44,35 +50,17 @@ std::string GetUploadData(const network::ResourceRequest& request) {
   return upload_data;
 }
 
-}  // namespace
-
-BraveRequestInfo::BraveRequestInfo() = default;
-
-BraveRequestInfo::BraveRequestInfo(const GURL& url) : request_url(url) {}
-
-BraveRequestInfo::~BraveRequestInfo() = default;
-
 // static
 std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
     const network::ResourceRequest& request,
     int render_process_id,
     int frame_tree_node_id,
     uint64_t request_identifier,
-    content::BrowserContext* browser_context,
-    std::shared_ptr<brave::BraveRequestInfo> old_ctx) {
+    content::BrowserContext* browser_context) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
   auto ctx = std::make_shared<brave::BraveRequestInfo>();
   ctx->request_identifier = request_identifier;
-  ctx->method = request.method;
-  ctx->request_url = request.url;
-  // TODO(iefremov): Replace GURL with Origin
-  ctx->initiator_url =
-      request.request_initiator.value_or(url::Origin()).GetURL();
-
-  ctx->referrer = request.referrer;
-  ctx->referrer_policy = request.referrer_policy;
-
   ctx->resource_type =
       static_cast<blink::mojom::ResourceType>(request.resource_type);
 
@@ -87,8 +75,57 @@ std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
   ctx->render_process_id = render_process_id;
   ctx->frame_tree_node_id = frame_tree_node_id;
 
+#if BUILDFLAG(IPFS_ENABLED)
+  auto* prefs = user_prefs::UserPrefs::Get(browser_context);
+  ctx->ipfs_local = static_cast<ipfs::IPFSResolveMethodTypes>(
+      prefs->GetInteger(kIPFSResolveMethod)) ==
+          ipfs::IPFSResolveMethodTypes::IPFS_LOCAL;
+#endif
+
+  UpdateCTX(request, browser_context, ctx.get());
+  return ctx;
+}
+
+// static
+void BraveRequestInfo::UpdateCTX(const network::ResourceRequest& request,
+                                 content::BrowserContext* browser_context,
+                                 BraveRequestInfo* ctx) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  // Results of the previous stage.
+  ctx->new_url = nullptr;
+  ctx->new_url_spec.clear();
+  ctx->new_referrer.reset();
+  ctx->next_url_request_index = 0;
+  ctx->headers = nullptr;
+  ctx->set_headers.clear();
+  ctx->removed_headers.clear();
+  ctx->original_response_headers = nullptr;
+  ctx->override_response_headers = nullptr;
+  ctx->allowed_unsafe_redirect_url = nullptr;
+  ctx->event_type = kUnknownEventType;
+  ctx->blocked_by = kNotBlocked;
+  ctx->mock_data_url.clear();
+
+  // These may change on redirects and are cheap to refresh.
+  ctx->method = request.method;
+  // TODO(iefremov): Replace GURL with Origin
+  ctx->initiator_url =
+      request.request_initiator.value_or(url::Origin()).GetURL();
+  ctx->referrer = request.referrer;
+  ctx->referrer_policy = request.referrer_policy;
+  ctx->request_body = request.request_body;
+
+  // Everything below only depends on the request url, which changes on
+  // redirects only.
+  if (ctx->settings_url_valid && ctx->request_url == request.url)
+    return;
+  ctx->request_url = request.url;
+  ctx->settings_url_valid = true;
+
   // TODO(iefremov): remove tab_url. Change tab_origin from GURL to Origin.
   // ctx->tab_url = request.top_frame_origin;
+  ctx->tab_origin = GURL();
   if (request.trusted_params) {
     // TODO(iefremov): Turns out it provides us a not expected value for
     // cross-site top-level navigations. Fortunately for now it is not a problem
@@ -112,11 +149,6 @@ std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
                               .GetOrigin();
   }
 
-  if (old_ctx) {
-    ctx->internal_redirect = old_ctx->internal_redirect;
-    ctx->redirect_source = old_ctx->redirect_source;
-  }
-
   Profile* profile = Profile::FromBrowserContext(browser_context);
   auto* map = HostContentSettingsMapFactory::GetForProfile(profile);
   ctx->allow_brave_shields =
@@ -126,31 +158,11 @@ std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
   ctx->allow_http_upgradable_resource =
       !brave_shields::GetHTTPSEverywhereEnabled(map, ctx->tab_origin);
 
-  // HACK: after we fix multiple creations of BraveRequestInfo we should
-  // use only tab_origin. Since we recreate BraveRequestInfo during consequent
-  // stages of navigation, |tab_origin| changes and so does |allow_referrers|
-  // flag, which is not what we want for determining referrers.
+  // |tab_origin| changes over the redirects of a navigation, so referrers
+  // are decided by the source of the redirect instead, if any.
   ctx->allow_referrers = brave_shields::AllowReferrers(
       map, ctx->redirect_source.is_empty() ? ctx->tab_origin :
                                              ctx->redirect_source);
-  ctx->upload_data = GetUploadData(request);
-
-#if BUILDFLAG(IPFS_ENABLED)
-  auto* prefs = user_prefs::UserPrefs::Get(browser_context);
-  ctx->ipfs_local = static_cast<ipfs::IPFSResolveMethodTypes>(
-      prefs->GetInteger(kIPFSResolveMethod)) ==
-          ipfs::IPFSResolveMethodTypes::IPFS_LOCAL;
-#endif
-
-  // TODO(fmarier): remove this once the hacky code in
-  // brave_proxying_url_loader_factory.cc is refactored. See
-  // BraveProxyingURLLoaderFactory::InProgressRequest::UpdateRequestInfo().
-  if (old_ctx) {
-    ctx->internal_redirect = old_ctx->internal_redirect;
-    ctx->redirect_source = old_ctx->redirect_source;
-  }
-
-  return ctx;
 }
 
 }  // namespace brave
@@ -10,6 +10,7 @@
 #include <set>
 #include <string>
 
+#include "base/memory/scoped_refptr.h"
 #include "net/base/network_isolation_key.h"
 #include "net/http/http_request_headers.h"
 #include "net/http/http_response_headers.h"
@@ -24,10 +25,12 @@ class BrowserContext;
 }
 
 namespace network {
+class ResourceRequestBody;
 struct ResourceRequest;
 }
 
 namespace brave {
+class ReferralHeadersMatcher;
 struct BraveRequestInfo;
 using ResponseCallback = base::Callback<void()>;
 }  // namespace brave
@@ -94,7 +97,7 @@ struct BraveRequestInfo {
 
   GURL* allowed_unsafe_redirect_url = nullptr;
   BraveNetworkDelegateEventType event_type = kUnknownEventType;
-  const base::ListValue* referral_headers_list = nullptr;
+  const ReferralHeadersMatcher* referral_headers_matcher = nullptr;
   BlockedBy blocked_by = kNotBlocked;
   std::string mock_data_url;
   bool ipfs_local = true;
@@ -113,15 +116,28 @@ struct BraveRequestInfo {
       static_cast<blink::mojom::ResourceType>(-1);
   blink::mojom::ResourceType resource_type = kInvalidResourceType;
 
-  std::string upload_data;
+  // Body of the request, kept by reference. Use GetUploadData() to read it.
+  scoped_refptr<network::ResourceRequestBody> request_body;
 
+  // Concatenates the bytes elements of |request_body|. This copies the
+  // whole body, so only call it for requests that actually need it.
+  std::string GetUploadData() const;
+
+  // Creates the context of a request, once per request.
   static std::shared_ptr<brave::BraveRequestInfo>
       MakeCTX(const network::ResourceRequest& request,
               int render_process_id,
               int frame_tree_node_id,
               uint64_t request_identifier,
-              content::BrowserContext* browser_context,
-              std::shared_ptr<brave::BraveRequestInfo> old_ctx);
+              content::BrowserContext* browser_context);
+
+  // Prepares |ctx| for the next stage of its request: clears the results of
+  // the previous stage and refreshes the fields |request| may have changed.
+  // The tab origin and shields settings are only looked up again when the
+  // request url changed, i.e. after a redirect.
+  static void UpdateCTX(const network::ResourceRequest& request,
+                        content::BrowserContext* browser_context,
+                        BraveRequestInfo* ctx);
 
  private:
   // Please don't add any more friends here if it can be avoided.
@@ -129,6 +145,8 @@ struct BraveRequestInfo {
   friend class ::BraveRequestHandler;
 
   GURL* new_url = nullptr;
+  // Whether the url dependent fields were computed for |request_url|.
+  bool settings_url_valid = false;
 
   DISALLOW_COPY_AND_ASSIGN(BraveRequestInfo);
 };
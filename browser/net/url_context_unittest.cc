@@ -0,0 +1,51 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/url_context.h"
+
+#include <memory>
+
+#include "chrome/test/base/testing_profile.h"
+#include "content/public/test/browser_task_environment.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+class BraveRequestInfoTest : public testing::Test {
+ protected:
+  content::BrowserTaskEnvironment task_environment_;
+  TestingProfile profile_;
+};
+
+TEST_F(BraveRequestInfoTest, RedirectStateSurvivesUpdate) {
+  const GURL source_url("https://a.com/redirect");
+  const GURL target_url("https://b.com/");
+
+  network::ResourceRequest request;
+  request.url = source_url;
+  request.method = "GET";
+  std::shared_ptr<BraveRequestInfo> ctx =
+      BraveRequestInfo::MakeCTX(request, 1, 1, 1, &profile_);
+  EXPECT_TRUE(ctx->redirect_source.is_empty());
+
+  // What the proxy does when the request is redirected.
+  ctx->redirect_source = source_url;
+  ctx->internal_redirect = true;
+  request.url = target_url;
+  BraveRequestInfo::UpdateCTX(request, &profile_, ctx.get());
+
+  EXPECT_EQ(ctx->request_url, target_url);
+  EXPECT_EQ(ctx->redirect_source, source_url);
+  EXPECT_TRUE(ctx->internal_redirect);
+
+  // Later stages of the redirected request keep it as well.
+  BraveRequestInfo::UpdateCTX(request, &profile_, ctx.get());
+  EXPECT_EQ(ctx->redirect_source, source_url);
+  EXPECT_TRUE(ctx->internal_redirect);
+}
+
+}  // namespace brave
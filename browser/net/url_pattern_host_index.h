@@ -0,0 +1,52 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_URL_PATTERN_HOST_INDEX_H_
+#define BRAVE_BROWSER_NET_URL_PATTERN_HOST_INDEX_H_
+
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_set.h"
+#include "base/strings/string_piece.h"
+
+class GURL;
+class URLPattern;
+
+namespace brave {
+
+// Indexes the hosts of a fixed set of URLPatterns so that URLs on unrelated
+// hosts can be rejected with a set lookup before any of the patterns has to
+// be matched. Scheme and path are left to the patterns themselves.
+class URLPatternHostIndex {
+ public:
+  explicit URLPatternHostIndex(const std::vector<const URLPattern*>& patterns);
+  URLPatternHostIndex(const URLPatternHostIndex&) = delete;
+  URLPatternHostIndex& operator=(const URLPatternHostIndex&) = delete;
+  ~URLPatternHostIndex();
+
+  // Returns false if none of the indexed patterns can match |url|.
+  bool MightMatch(const GURL& url) const;
+
+ private:
+  struct StringPieceLess {
+    using is_transparent = void;
+    bool operator()(base::StringPiece lhs, base::StringPiece rhs) const {
+      return lhs < rhs;
+    }
+  };
+
+  using HostSet = base::flat_set<std::string, StringPieceLess>;
+
+  HostSet hosts_;
+  // Hosts of patterns like "*://*.example.com/*", which also match any
+  // subdomain.
+  HostSet subdomain_hosts_;
+  bool matches_all_hosts_ = false;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_URL_PATTERN_HOST_INDEX_H_
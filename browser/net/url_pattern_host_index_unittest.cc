@@ -0,0 +1,56 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/url_pattern_host_index.h"
+
+#include "extensions/common/url_pattern.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+TEST(URLPatternHostIndexTest, MatchesIndexedHosts) {
+  const URLPattern exact_pattern(URLPattern::SCHEME_HTTPS,
+                                 "https://www.example.com/path/*");
+  const URLPattern subdomain_pattern(
+      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
+      "*://*.example.org/*");
+  const URLPatternHostIndex index({&exact_pattern, &subdomain_pattern});
+
+  EXPECT_TRUE(index.MightMatch(GURL("https://www.example.com/path/a")));
+  // Path and scheme are not checked by the index.
+  EXPECT_TRUE(index.MightMatch(GURL("http://www.example.com/other")));
+  EXPECT_TRUE(index.MightMatch(GURL("https://www.example.com./path/a")));
+  EXPECT_TRUE(index.MightMatch(GURL("https://example.org/")));
+  EXPECT_TRUE(index.MightMatch(GURL("https://a.b.example.org/")));
+
+  EXPECT_FALSE(index.MightMatch(GURL("https://example.com/path/a")));
+  EXPECT_FALSE(index.MightMatch(GURL("https://sub.www.example.com/path/a")));
+  EXPECT_FALSE(index.MightMatch(GURL("https://notexample.org/")));
+  EXPECT_FALSE(index.MightMatch(GURL("https://example.org.evil.com/")));
+}
+
+TEST(URLPatternHostIndexTest, RejectsUnrelatedHostsWithOnlySubdomainPatterns) {
+  const URLPattern subdomain_pattern(
+      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
+      "*://*.gvt1.com/*");
+  const URLPatternHostIndex index({&subdomain_pattern});
+
+  EXPECT_TRUE(index.MightMatch(GURL("https://gvt1.com/")));
+  EXPECT_TRUE(index.MightMatch(GURL("https://redirector.gvt1.com/edgedl/")));
+
+  EXPECT_FALSE(index.MightMatch(GURL("https://brave.com/")));
+  EXPECT_FALSE(index.MightMatch(GURL("https://gvt1.com.example.org/")));
+  EXPECT_FALSE(index.MightMatch(GURL("https://notgvt1.com/")));
+}
+
+TEST(URLPatternHostIndexTest, MatchesAllHosts) {
+  const URLPattern all_urls_pattern(URLPattern::SCHEME_ALL, "<all_urls>");
+  const URLPatternHostIndex index({&all_urls_pattern});
+
+  EXPECT_TRUE(index.MightMatch(GURL("https://brave.com/")));
+}
+
+}  // namespace brave
@@ -20,6 +20,7 @@
 #include "third_party/blink/public/common/features.h"
 
 using brave_shields::features::kBraveAdblockCosmeticFiltering;
+using brave_shields::features::kBraveNativeCosmeticFiltering;
 using ntp_background_images::features::kBraveNTPBrandedWallpaper;
 using ntp_background_images::features::kBraveNTPBrandedWallpaperDemo;
 using ntp_background_images::features::kBraveNTPSuperReferralWallpaper;
@@ -78,6 +79,11 @@ using ntp_background_images::features::kBraveNTPSuperReferralWallpaper;
      flag_descriptions::kBraveAdblockCosmeticFilteringName,                \
      flag_descriptions::kBraveAdblockCosmeticFilteringDescription, kOsAll, \
      FEATURE_VALUE_TYPE(kBraveAdblockCosmeticFiltering)},                  \
+    {"brave-native-cosmetic-filtering",                                    \
+     flag_descriptions::kBraveNativeCosmeticFilteringName,                 \
+     flag_descriptions::kBraveNativeCosmeticFilteringDescription,          \
+     kOsDesktop,                                                           \
+     FEATURE_VALUE_TYPE(kBraveNativeCosmeticFiltering)},                   \
     SPEEDREADER_FEATURE_ENTRIES                                            \
     BRAVE_SYNC_FEATURE_ENTRIES                                             \
     BRAVE_IPFS_FEATURE_ENTRIES                                             \
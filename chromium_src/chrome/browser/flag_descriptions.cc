@@ -24,6 +24,11 @@ const char kBraveNTPBrandedWallpaperDemoDescription[] =
 const char kBraveAdblockCosmeticFilteringName[] = "Enable cosmetic filtering";
 const char kBraveAdblockCosmeticFilteringDescription[] =
     "Enable support for cosmetic filtering";
+const char kBraveNativeCosmeticFilteringName[] =
+    "Enable native cosmetic filtering";
+const char kBraveNativeCosmeticFilteringDescription[] =
+    "Apply cosmetic filters from the renderer instead of the Brave extension "
+    "content script";
 const char kBraveSpeedreaderName[] = "Enable SpeedReader";
 const char kBraveSpeedreaderDescription[] =
     "Enables faster loading of simplified article-style web pages.";
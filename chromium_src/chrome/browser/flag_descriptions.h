@@ -17,6 +17,8 @@ extern const char kBraveNTPBrandedWallpaperDemoName[];
 extern const char kBraveNTPBrandedWallpaperDemoDescription[];
 extern const char kBraveAdblockCosmeticFilteringName[];
 extern const char kBraveAdblockCosmeticFilteringDescription[];
+extern const char kBraveNativeCosmeticFilteringName[];
+extern const char kBraveNativeCosmeticFilteringDescription[];
 extern const char kGlobalPrivacyControlName[];
 extern const char kGlobalPrivacyControlDescription[];
 extern const char kBraveSpeedreaderName[];
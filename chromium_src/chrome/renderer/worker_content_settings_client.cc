@@ -9,6 +9,16 @@
 #include "components/content_settings/renderer/content_settings_agent_impl.h"
 
 BraveFarblingLevel WorkerContentSettingsClient::GetBraveFarblingLevel() {
+  // The origins of a worker never change, so the level only needs to be
+  // computed once.
+  if (!content_setting_rules_)
+    return ComputeBraveFarblingLevel();
+  if (!brave_farbling_level_)
+    brave_farbling_level_ = ComputeBraveFarblingLevel();
+  return *brave_farbling_level_;
+}
+
+BraveFarblingLevel WorkerContentSettingsClient::ComputeBraveFarblingLevel() {
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
   if (content_setting_rules_) {
     const GURL& primary_url = top_frame_origin_.GetURL();
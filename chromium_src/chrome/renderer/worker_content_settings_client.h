@@ -6,9 +6,18 @@
 #ifndef BRAVE_CHROMIUM_SRC_CHROME_RENDERER_WORKER_CONTENT_SETTINGS_CLIENT_H_
 #define BRAVE_CHROMIUM_SRC_CHROME_RENDERER_WORKER_CONTENT_SETTINGS_CLIENT_H_
 
-#define BRAVE_WORKER_CONTENT_SETTINGS_CLIENT_H         \
-  BraveFarblingLevel GetBraveFarblingLevel() override; \
-  bool AllowFingerprinting(bool enabled_per_settings) override;
+#include "base/optional.h"
+#include "brave/third_party/blink/renderer/brave_farbling_constants.h"
+
+#define BRAVE_WORKER_CONTENT_SETTINGS_CLIENT_H                  \
+  BraveFarblingLevel GetBraveFarblingLevel() override;          \
+  bool AllowFingerprinting(bool enabled_per_settings) override; \
+                                                                \
+ private:                                                       \
+  BraveFarblingLevel ComputeBraveFarblingLevel();               \
+  base::Optional<BraveFarblingLevel> brave_farbling_level_;     \
+                                                                \
+ public:
 
 #include "../../../../chrome/renderer/worker_content_settings_client.h"
 
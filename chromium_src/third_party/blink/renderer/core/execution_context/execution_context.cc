@@ -258,6 +258,19 @@ std::mt19937_64 BraveSessionCache::MakePseudoRandomGenerator() {
   return std::mt19937_64(seed);
 }
 
+bool BraveSessionCache::GetPseudoRandomBit(size_t index) {
+  DCHECK_LT(index, kPseudoRandomBitCount);
+  if (!pseudo_random_bits_ready_) {
+    std::mt19937_64 prng = MakePseudoRandomGenerator();
+    for (size_t i = 0; i < kPseudoRandomBitCount; i++) {
+      if (prng() % 2 != 0)
+        pseudo_random_bits_ |= uint64_t{1} << i;
+    }
+    pseudo_random_bits_ready_ = true;
+  }
+  return (pseudo_random_bits_ >> index) & 1;
+}
+
 }  // namespace brave
 
 #include "../../../../../../../third_party/blink/renderer/core/execution_context/execution_context.cc"
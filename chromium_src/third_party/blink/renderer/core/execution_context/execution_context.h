@@ -51,11 +51,21 @@ class CORE_EXPORT BraveSessionCache final
   WTF::String GenerateRandomString(std::string seed, wtf_size_t length);
   WTF::String FarbledUserAgent(WTF::String real_user_agent);
   std::mt19937_64 MakePseudoRandomGenerator();
+  // Returns whether the output at |index| of the generator returned by
+  // MakePseudoRandomGenerator() is odd, without constructing a generator on
+  // every call. |index| must be less than kPseudoRandomBitCount.
+  bool GetPseudoRandomBit(size_t index);
+
+  static constexpr size_t kPseudoRandomBitCount = 64;
 
  private:
   bool farbling_enabled_;
   uint64_t session_key_;
   uint8_t domain_key_[32];
+  // Parity of the first kPseudoRandomBitCount generator outputs, derived on
+  // first use.
+  uint64_t pseudo_random_bits_ = 0;
+  bool pseudo_random_bits_ready_ = false;
 
   scoped_refptr<blink::StaticBitmapImage> PerturbPixelsInternal(
       scoped_refptr<blink::StaticBitmapImage> image_bitmap);
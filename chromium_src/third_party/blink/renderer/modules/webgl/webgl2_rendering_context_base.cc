@@ -24,14 +24,10 @@ ScriptValue FarbleGLIntParameter(WebGL2RenderingContextBase* owner,
   GLint value = 0;
   if (!owner->isContextLost())
     owner->ContextGL()->GetIntegerv(pname, &value);
-  if (value > 0) {
-    std::mt19937_64 prng =
-        brave::BraveSessionCache::From(*ExecutionContext::From(script_state))
-            .MakePseudoRandomGenerator();
-    prng.discard(discard);
-    if (prng() % 2 != 0) {
-      value = value - 1;
-    }
+  if (value > 0 &&
+      brave::BraveSessionCache::From(*ExecutionContext::From(script_state))
+          .GetPseudoRandomBit(discard)) {
+    value = value - 1;
   }
   return WebGLAny(script_state, value);
 }
@@ -43,14 +39,10 @@ ScriptValue FarbleGLInt64Parameter(WebGL2RenderingContextBase* owner,
   GLint64 value = 0;
   if (!owner->isContextLost())
     owner->ContextGL()->GetInteger64v(pname, &value);
-  if (value > 0) {
-    std::mt19937_64 prng =
-        brave::BraveSessionCache::From(*ExecutionContext::From(script_state))
-            .MakePseudoRandomGenerator();
-    prng.discard(discard);
-    if (prng() % 2 != 0) {
-      value = value - 1;
-    }
+  if (value > 0 &&
+      brave::BraveSessionCache::From(*ExecutionContext::From(script_state))
+          .GetPseudoRandomBit(discard)) {
+    value = value - 1;
   }
   return WebGLAny(script_state, value);
 }
@@ -65,7 +57,9 @@ ScriptValue FarbleGLInt64Parameter(WebGL2RenderingContextBase* owner,
   if (ExecutionContext* context = ExecutionContext::From(script_state)) {     \
     if (WebContentSettingsClient* settings =                                  \
         brave::GetContentSettingsClientFor(context)) {                  \
-      if (settings->GetBraveFarblingLevel() == BraveFarblingLevel::MAXIMUM) { \
+      const BraveFarblingLevel farbling_level =                               \
+          settings->GetBraveFarblingLevel();                                  \
+      if (farbling_level == BraveFarblingLevel::MAXIMUM) {                    \
         switch (pname) {                                                      \
           case GL_SHADING_LANGUAGE_VERSION:                                   \
           case GL_VERSION:                                                    \
@@ -86,8 +80,7 @@ ScriptValue FarbleGLInt64Parameter(WebGL2RenderingContextBase* owner,
           case GL_MAX_COMBINED_FRAGMENT_UNIFORM_COMPONENTS:                   \
             return ScriptValue::CreateNull(script_state->GetIsolate());       \
         }                                                                     \
-      } else if (settings->GetBraveFarblingLevel() ==                         \
-                 BraveFarblingLevel::BALANCED) {                              \
+      } else if (farbling_level == BraveFarblingLevel::BALANCED) {            \
         switch (pname) {                                                      \
           case GL_MAX_VERTEX_UNIFORM_COMPONENTS:                              \
             return FarbleGLIntParameter(this, script_state, pname, 1);        \
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
 
 namespace brave_component_updater {
 
@@ -20,6 +21,10 @@ using DATFileDataBuffer = std::vector<unsigned char>;
 void GetDATFileData(const base::FilePath& file_path,
                     DATFileDataBuffer* buffer);
 std::string GetDATFileAsString(const base::FilePath& file_path);
+// Maps |file_path| read-only. Returns nullptr if the file is missing, empty or
+// can't be mapped.
+std::unique_ptr<base::MemoryMappedFile> MapDATFile(
+    const base::FilePath& file_path);
 
 template<typename T>
 using LoadDATFileDataResult =
@@ -41,6 +46,26 @@ LoadDATFileDataResult<T> LoadDATFileData(
       std::move(client), std::move(buffer));
 }
 
+// Like LoadDATFileData, but deserializes straight from a memory mapping of
+// the file instead of reading it into a buffer first. Only use this for types
+// whose deserialize() copies what it needs, since the mapping is released
+// before returning. Returns nullptr if the file can't be mapped or
+// deserialized.
+template<typename T>
+std::unique_ptr<T> LoadMappedDATFileData(
+    const base::FilePath& dat_file_path) {
+  std::unique_ptr<base::MemoryMappedFile> mapped_file =
+      MapDATFile(dat_file_path);
+  if (!mapped_file)
+    return nullptr;
+  std::unique_ptr<T> client = std::make_unique<T>();
+  if (!client->deserialize(
+          reinterpret_cast<const char*>(mapped_file->data()),
+          mapped_file->length()))
+    client.reset();
+
+  return client;
+}
 
 }  // namespace brave_component_updater
 
@@ -46,7 +46,7 @@ export const applyAdblockCosmeticFilters = (tabId: number, frameId: number, url:
       return
     }
 
-    if (frameId === 0) {
+    if (frameId === 0 && !resources.observe_mutations_only) {
       if (hide1pContent) {
         resources.force_hide_selectors.push(...resources.hide_selectors)
       } else {
@@ -67,7 +67,7 @@ export const applyAdblockCosmeticFilters = (tabId: number, frameId: number, url:
       })
     }
 
-    shieldsPanelActions.cosmeticFilterRuleExceptions(tabId, frameId, resources.exceptions, resources.injected_script || '', resources.generichide)
+    shieldsPanelActions.cosmeticFilterRuleExceptions(tabId, frameId, resources.exceptions, resources.injected_script || '', resources.generichide, resources.observe_mutations_only)
   })
 }
 
@@ -3,11 +3,14 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 import actions from '../actions/shieldsPanelActions'
-import { BlockDetails } from '../../types/actions/shieldsPanelActions'
+import { BlockedBatchDetails } from '../../types/actions/shieldsPanelActions'
 
 if (chrome.braveShields) {
-  chrome.braveShields.onBlocked.addListener((detail: BlockDetails) => {
-    actions.resourceBlocked(detail)
+  chrome.braveShields.onBlocked.addListener((detail: BlockedBatchDetails) => {
+    const { blockType, tabId } = detail
+    for (const subresource of detail.subresources) {
+      actions.resourceBlocked({ blockType, tabId, subresource })
+    }
   })
 } else {
   console.log('chrome.braveShields not enabled')
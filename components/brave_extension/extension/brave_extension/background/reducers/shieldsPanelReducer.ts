@@ -382,7 +382,7 @@ export default function shieldsPanelReducer (
         console.error('Active tab not found')
         break
       }
-      let message: { type: string, scriptlet: string, hideOptions?: { hide1pContent: boolean, generichide: boolean } } = {
+      let message: { type: string, scriptlet: string, hideOptions?: { hide1pContent: boolean, generichide: boolean, observeMutationsOnly: boolean } } = {
         type: 'cosmeticFilteringBackgroundReady',
         scriptlet: action.scriptlet,
         hideOptions: undefined
@@ -392,7 +392,8 @@ export default function shieldsPanelReducer (
         state = shieldsPanelState.saveCosmeticFilterRuleExceptions(state, action.tabId, action.exceptions)
         message.hideOptions = {
           hide1pContent: tabData.firstPartyCosmeticFiltering,
-          generichide: action.generichide
+          generichide: action.generichide,
+          observeMutationsOnly: action.observeMutationsOnly
         }
       }
       chrome.tabs.sendMessage(action.tabId, message, {
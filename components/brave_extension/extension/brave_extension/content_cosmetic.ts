@@ -497,23 +497,25 @@ const pumpCosmeticFilterQueuesOnIdle = idleize(
   pumpIntervalMaxMs
 )
 
-const startObserving = () => {
+const startObserving = (observeMutationsOnly: boolean) => {
   // First queue up any classes and ids that exist before the mutation observer
-  // starts running.
-  const elmWithClassOrId = document.querySelectorAll('[class],[id]')
-  for (const elm of elmWithClassOrId) {
-    for (const aClassName of elm.classList.values()) {
-      queriedClasses.add(aClassName)
-    }
-    const elmId = elm.getAttribute('id')
-    if (elmId) {
-      queriedIds.add(elmId)
+  // starts running, unless native cosmetic filtering already handled them.
+  if (!observeMutationsOnly) {
+    const elmWithClassOrId = document.querySelectorAll('[class],[id]')
+    for (const elm of elmWithClassOrId) {
+      for (const aClassName of elm.classList.values()) {
+        queriedClasses.add(aClassName)
+      }
+      const elmId = elm.getAttribute('id')
+      if (elmId) {
+        queriedIds.add(elmId)
+      }
     }
-  }
 
-  notYetQueriedClasses = Array.from(queriedClasses)
-  notYetQueriedIds = Array.from(queriedIds)
-  fetchNewClassIdRules()
+    notYetQueriedClasses = Array.from(queriedClasses)
+    notYetQueriedIds = Array.from(queriedIds)
+    fetchNewClassIdRules()
+  }
 
   // Second, set up a mutation observer to handle any new ids or classes
   // that are added to the document.
@@ -528,7 +530,7 @@ const startObserving = () => {
 
 let _hasDelayOcurred: boolean = false
 let _startCheckingId: number | undefined = undefined
-const scheduleQueuePump = (hide1pContent: boolean, generichide: boolean) => {
+const scheduleQueuePump = (hide1pContent: boolean, generichide: boolean, observeMutationsOnly: boolean = false) => {
   // Three states possible here.  First, the delay has already occurred.  If so,
   // pass through to pumpCosmeticFilterQueues immediately.
   if (_hasDelayOcurred === true) {
@@ -545,7 +547,7 @@ const scheduleQueuePump = (hide1pContent: boolean, generichide: boolean) => {
   _startCheckingId = window.requestIdleCallback(function ({ didTimeout }) {
     _hasDelayOcurred = true
     if (!generichide) {
-      startObserving()
+      startObserving(observeMutationsOnly)
     }
     if (!hide1pContent) {
       pumpCosmeticFilterQueuesOnIdle()
@@ -560,7 +562,7 @@ chrome.runtime.onMessage.addListener((msg, sender, sendResponse) => {
   switch (action) {
     case 'cosmeticFilteringBackgroundReady': {
       if (msg.hideOptions !== undefined) {
-        scheduleQueuePump(msg.hideOptions.hide1pContent, msg.hideOptions.generichide)
+        scheduleQueuePump(msg.hideOptions.hide1pContent, msg.hideOptions.generichide, msg.hideOptions.observeMutationsOnly)
       }
       injectScriptlet(msg.scriptlet)
       break
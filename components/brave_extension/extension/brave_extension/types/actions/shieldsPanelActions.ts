@@ -24,6 +24,12 @@ export interface BlockDetails {
   subresource: string
 }
 
+export interface BlockedBatchDetails {
+  blockType: BlockTypes
+  tabId: number
+  subresources: string[]
+}
+
 interface ShieldsPanelDataUpdatedReturn {
   type: types.SHIELDS_PANEL_DATA_UPDATED
   details: ShieldDetails
@@ -190,11 +196,12 @@ interface CosmeticFilterRuleExceptionsReturn {
   frameId: number,
   exceptions: string[],
   scriptlet: string,
-  generichide: boolean
+  generichide: boolean,
+  observeMutationsOnly: boolean
 }
 
 export interface CosmeticFilterRuleExceptions {
-  (tabId: number, frameId: number, exceptions: string[], scriptlet: string, generichide: boolean): CosmeticFilterRuleExceptionsReturn
+  (tabId: number, frameId: number, exceptions: string[], scriptlet: string, generichide: boolean, observeMutationsOnly: boolean): CosmeticFilterRuleExceptionsReturn
 }
 
 interface ContentScriptsLoadedReturn {
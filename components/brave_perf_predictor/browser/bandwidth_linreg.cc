@@ -8,9 +8,12 @@
 #include <algorithm>
 #include <cmath>
 #include <numeric>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/logging.h"
+#include "base/no_destructor.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 
 namespace brave_perf_predictor {
@@ -35,6 +38,17 @@ bool StandardiseFeatsNoOutliers(
   return false;
 }
 
+const base::flat_map<std::string, int>& GetFeatureIndices() {
+  static const base::NoDestructor<base::flat_map<std::string, int>> indices(
+      [] {
+        std::vector<std::pair<std::string, int>> entries;
+        for (int i = 0; i < feature_count; i++)
+          entries.emplace_back(feature_sequence[i], i);
+        return base::flat_map<std::string, int>(std::move(entries));
+      }());
+  return *indices;
+}
+
 }  // namespace
 
 double LinregPredictVector(const std::array<double, feature_count>& features) {
@@ -75,4 +89,12 @@ double LinregPredictNamed(const base::flat_map<std::string, double>& features) {
   return LinregPredictVector(feature_vector);
 }
 
+int GetFeatureIndex(const std::string& feature) {
+  const auto& indices = GetFeatureIndices();
+  auto it = indices.find(feature);
+  if (it == indices.end())
+    return -1;
+  return it->second;
+}
+
 }  // namespace brave_perf_predictor
@@ -31,6 +31,10 @@ double LinregPredictVector(const std::array<double, feature_count>& features);
 // any extra features.
 double LinregPredictNamed(const base::flat_map<std::string, double>& features);
 
+// Returns the position of |feature| in the feature vector expected by
+// |LinregPredictVector|, or -1 if the model does not use the feature.
+int GetFeatureIndex(const std::string& feature);
+
 }  // namespace brave_perf_predictor
 
 #endif  // BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_LINREG_H_
@@ -5,9 +5,18 @@
 
 #include "brave/components/brave_perf_predictor/browser/bandwidth_savings_predictor.h"
 
+#include <string.h>
+
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <utility>
+#include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_util.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 #include "components/page_load_metrics/common/page_load_metrics.mojom.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
@@ -15,44 +24,116 @@
 
 namespace brave_perf_predictor {
 
+namespace {
+
+constexpr char kThirdPartyFeaturePrefix[] = "thirdParties.";
+constexpr char kThirdPartyBlockedFeatureSuffix[] = ".blocked";
+
+struct ResourceFeatureSlots {
+  explicit ResourceFeatureSlots(const std::string& resource_type)
+      : request_count(
+            GetFeatureIndex("resources." + resource_type + ".requestCount")),
+        size(GetFeatureIndex("resources." + resource_type + ".size")) {}
+
+  const int request_count;
+  const int size;
+};
+
+// Positions of the features we accumulate in the model's feature vector.
+struct FeatureSlots {
+  FeatureSlots() {
+    std::vector<std::pair<std::string, int>> third_party_entries;
+    for (int i = 0; i < feature_count; i++) {
+      const std::string& feature = feature_sequence[i];
+      if (base::StartsWith(feature, kThirdPartyFeaturePrefix,
+                           base::CompareCase::SENSITIVE) &&
+          base::EndsWith(feature, kThirdPartyBlockedFeatureSuffix,
+                         base::CompareCase::SENSITIVE)) {
+        const size_t prefix_length = strlen(kThirdPartyFeaturePrefix);
+        third_party_entries.emplace_back(
+            feature.substr(prefix_length,
+                           feature.size() - prefix_length -
+                               strlen(kThirdPartyBlockedFeatureSuffix)),
+            i);
+      }
+    }
+    third_party_blocked =
+        base::flat_map<std::string, int>(std::move(third_party_entries));
+  }
+
+  const int adblock_requests = GetFeatureIndex("adblockRequests");
+  const int first_meaningful_paint =
+      GetFeatureIndex("metrics.firstMeaningfulPaint");
+  const int observed_dom_content_loaded =
+      GetFeatureIndex("metrics.observedDomContentLoaded");
+  const int observed_first_visual_change =
+      GetFeatureIndex("metrics.observedFirstVisualChange");
+  const int observed_load = GetFeatureIndex("metrics.observedLoad");
+  const ResourceFeatureSlots third_party{"third-party"};
+  const ResourceFeatureSlots total{"total"};
+  const ResourceFeatureSlots document{"document"};
+  const ResourceFeatureSlots stylesheet{"stylesheet"};
+  const ResourceFeatureSlots script{"script"};
+  const ResourceFeatureSlots image{"image"};
+  const ResourceFeatureSlots font{"font"};
+  const ResourceFeatureSlots media{"media"};
+  const ResourceFeatureSlots other{"other"};
+  // Third party name to its "thirdParties.<name>.blocked" feature slot.
+  base::flat_map<std::string, int> third_party_blocked;
+};
+
+const FeatureSlots& GetFeatureSlots() {
+  static const base::NoDestructor<FeatureSlots> slots;
+  return *slots;
+}
+
+}  // namespace
+
 BandwidthSavingsPredictor::BandwidthSavingsPredictor(
     const NamedThirdPartyRegistry* registry)
-    : tp_registry_(registry) {}
+    : tp_registry_(registry), features_(feature_count) {}
 
 BandwidthSavingsPredictor::~BandwidthSavingsPredictor() = default;
 
 void BandwidthSavingsPredictor::OnPageLoadTimingUpdated(
     const page_load_metrics::mojom::PageLoadTiming& timing) {
+  const FeatureSlots& slots = GetFeatureSlots();
+
   // First meaningful paint
   if (timing.paint_timing->first_meaningful_paint.has_value())
-    feature_map_["metrics.firstMeaningfulPaint"] =
+    features_[slots.first_meaningful_paint] =
         timing.paint_timing->first_meaningful_paint.value().InMillisecondsF();
 
   // DOM Content Loaded
   if (timing.document_timing->dom_content_loaded_event_start.has_value())
-    feature_map_["metrics.observedDomContentLoaded"] =
+    features_[slots.observed_dom_content_loaded] =
         timing.document_timing->dom_content_loaded_event_start.value()
             .InMillisecondsF();
 
   // First contentful paint
   if (timing.paint_timing->first_contentful_paint.has_value())
-    feature_map_["metrics.observedFirstVisualChange"] =
+    features_[slots.observed_first_visual_change] =
         timing.paint_timing->first_contentful_paint.value().InMillisecondsF();
 
   // Load
   if (timing.document_timing->load_event_start.has_value())
-    feature_map_["metrics.observedLoad"] =
+    features_[slots.observed_load] =
         timing.document_timing->load_event_start.value().InMillisecondsF();
 }
 
 void BandwidthSavingsPredictor::OnSubresourceBlocked(
     const std::string& resource_url) {
-  feature_map_["adblockRequests"] += 1;
+  const FeatureSlots& slots = GetFeatureSlots();
+  AddToFeature(slots.adblock_requests, 1);
 
   if (tp_registry_) {
     const auto tp_name = tp_registry_->GetThirdParty(resource_url);
-    if (tp_name.has_value())
-      feature_map_["thirdParties." + tp_name.value() + ".blocked"] = 1;
+    if (tp_name.has_value()) {
+      // Third parties the model doesn't know about don't affect predictions.
+      auto it = slots.third_party_blocked.find(tp_name.value());
+      if (it != slots.third_party_blocked.end())
+        features_[it->second] = 1;
+    }
   }
 }
 
@@ -72,48 +153,46 @@ void BandwidthSavingsPredictor::OnResourceLoadComplete(
           main_frame_url, resource_load_info.final_url,
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
+  const FeatureSlots& slots = GetFeatureSlots();
   if (is_third_party) {
-    feature_map_["resources.third-party.requestCount"] += 1;
-    feature_map_["resources.third-party.size"] +=
-        resource_load_info.raw_body_bytes;
+    AddToFeature(slots.third_party.request_count, 1);
+    AddToFeature(slots.third_party.size, resource_load_info.raw_body_bytes);
   }
 
-  feature_map_["resources.total.requestCount"] += 1;
-  feature_map_["resources.total.size"] += resource_load_info.raw_body_bytes;
-  feature_map_["transfer.total.size"] +=
-      resource_load_info.total_received_bytes;
-  std::string resource_type;
+  AddToFeature(slots.total.request_count, 1);
+  AddToFeature(slots.total.size, resource_load_info.raw_body_bytes);
+  transfer_total_size_ += resource_load_info.total_received_bytes;
+  const ResourceFeatureSlots* resource_type;
   switch (resource_load_info.request_destination) {
     case network::mojom::RequestDestination::kDocument:
-      resource_type = "document";
+      resource_type = &slots.document;
       break;
     case network::mojom::RequestDestination::kIframe:
-      resource_type = "document";
+      resource_type = &slots.document;
       break;
     case network::mojom::RequestDestination::kStyle:
-      resource_type = "stylesheet";
+      resource_type = &slots.stylesheet;
       break;
     case network::mojom::RequestDestination::kScript:
-      resource_type = "script";
+      resource_type = &slots.script;
       break;
     case network::mojom::RequestDestination::kImage:
-      resource_type = "image";
+      resource_type = &slots.image;
       break;
     case network::mojom::RequestDestination::kFont:
-      resource_type = "font";
+      resource_type = &slots.font;
       break;
     case network::mojom::RequestDestination::kAudio:
     case network::mojom::RequestDestination::kTrack:
     case network::mojom::RequestDestination::kVideo:
-      resource_type = "media";
+      resource_type = &slots.media;
       break;
     default:
-      resource_type = "other";
+      resource_type = &slots.other;
       break;
   }
-  feature_map_["resources." + resource_type + ".requestCount"] += 1;
-  feature_map_["resources." + resource_type + ".size"] +=
-      resource_load_info.raw_body_bytes;
+  AddToFeature(resource_type->request_count, 1);
+  AddToFeature(resource_type->size, resource_load_info.raw_body_bytes);
 }
 
 double BandwidthSavingsPredictor::PredictSavingsBytes() const {
@@ -121,38 +200,47 @@ double BandwidthSavingsPredictor::PredictSavingsBytes() const {
       !main_frame_url_.SchemeIsHTTPOrHTTPS()) {
     return 0;
   }
-  const auto total_size = feature_map_.find("transfer.total.size");
-  if (total_size != feature_map_.end() && total_size->second > 0) {
-    VLOG(2) << main_frame_url_ << " total download size " << total_size->second
-            << " bytes";
+  if (transfer_total_size_ > 0) {
+    VLOG(2) << main_frame_url_ << " total download size "
+            << transfer_total_size_ << " bytes";
   } else {
     return 0;
   }
 
   // Short-circuit if nothing got blocked
-  const auto adblock_requests = feature_map_.find("adblockRequests");
-  if (adblock_requests == feature_map_.end() || adblock_requests->second < 1) {
+  if (features_[GetFeatureSlots().adblock_requests] < 1) {
     return 0;
   }
   if (VLOG_IS_ON(3)) {
-    VLOG(3) << "Predicting on feature map:";
-    for (const auto& feature : feature_map_) {
-      VLOG(3) << feature.first << " :: " << feature.second;
+    VLOG(3) << "Predicting on feature vector:";
+    for (int i = 0; i < feature_count; i++) {
+      if (features_[i] != 0)
+        VLOG(3) << feature_sequence[i] << " :: " << features_[i];
     }
   }
-  double prediction = ::brave_perf_predictor::LinregPredictNamed(feature_map_);
+  std::array<double, feature_count> feature_vector;
+  std::copy(features_.begin(), features_.end(), feature_vector.begin());
+  double prediction =
+      ::brave_perf_predictor::LinregPredictVector(feature_vector);
   VLOG(2) << main_frame_url_ << " estimated saving " << prediction << " bytes";
   // Sanity check for predicted saving
   if (prediction > kSavingsAbsoluteOutlier &&
-      (prediction / kOutlierThreshold) > total_size->second) {
+      (prediction / kOutlierThreshold) > transfer_total_size_) {
     return 0;
   }
   return prediction;
 }
 
 void BandwidthSavingsPredictor::Reset() {
-  feature_map_.clear();
+  std::fill(features_.begin(), features_.end(), 0);
+  transfer_total_size_ = 0;
   main_frame_url_ = {};
 }
 
+void BandwidthSavingsPredictor::AddToFeature(int index, double value) {
+  DCHECK_GE(index, 0);
+  if (index >= 0)
+    features_[index] += value;
+}
+
 }  // namespace brave_perf_predictor
@@ -7,9 +7,8 @@
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_SAVINGS_PREDICTOR_H_
 
 #include <string>
+#include <vector>
 
-#include "base/containers/flat_map.h"
-#include "base/gtest_prod_util.h"
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 #include "url/gurl.h"
 
@@ -37,7 +36,8 @@ namespace brave_perf_predictor {
 //
 // The predictor expects to receive a series of |PageLoadTiming| inputs to
 // extract relevant standard performance metrics from, as well as notifications
-// of any resources fully loaded or blocked.
+// of any resources fully loaded or blocked. Features are accumulated directly
+// into the model's feature vector, whose slots are resolved once per process.
 class BandwidthSavingsPredictor {
  public:
   explicit BandwidthSavingsPredictor(const NamedThirdPartyRegistry* registry);
@@ -57,14 +57,16 @@ class BandwidthSavingsPredictor {
   void Reset();
 
  private:
-  FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest, FeaturiseBlocked);
-  FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest, FeaturiseTiming);
-  FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest,
-                           FeaturiseResourceLoading);
+  friend class BandwidthSavingsPredictorTest;
+
+  void AddToFeature(int index, double value);
 
   GURL main_frame_url_;
   const NamedThirdPartyRegistry* tp_registry_;  // not owned
-  base::flat_map<std::string, double> feature_map_;
+  // Indexed like the model's feature vector, see |GetFeatureIndex|.
+  std::vector<double> features_;
+  // Not a model feature, only used to sanity check predictions.
+  double transfer_total_size_ = 0;
 };
 
 }  // namespace brave_perf_predictor
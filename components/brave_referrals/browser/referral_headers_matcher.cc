@@ -0,0 +1,84 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/strings/string_util.h"
+#include "base/values.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+ReferralHeadersMatcher::ReferralHeadersMatcher(
+    const base::ListValue& referral_headers_list) {
+  for (const auto& headers_value : referral_headers_list) {
+    const base::Value* domains_list =
+        headers_value.FindKeyOfType("domains", base::Value::Type::LIST);
+    if (!domains_list) {
+      LOG(WARNING) << "Failed to retrieve 'domains' key from referral headers";
+      continue;
+    }
+    const base::Value* headers_dict =
+        headers_value.FindKeyOfType("headers", base::Value::Type::DICTIONARY);
+    if (!headers_dict) {
+      LOG(WARNING) << "Failed to retrieve 'headers' key from referral headers";
+      continue;
+    }
+
+    Headers headers;
+    for (const auto& it : headers_dict->DictItems()) {
+      if (!it.second.is_string())
+        continue;
+      headers.emplace_back(it.first, it.second.GetString());
+    }
+
+    const size_t index = headers_.size();
+    headers_.push_back(std::move(headers));
+
+    for (const auto& domain_value : domains_list->GetList()) {
+      if (!domain_value.is_string())
+        continue;
+      // Earlier entries take precedence, so the first index for a domain
+      // is kept.
+      domains_.emplace(base::ToLowerASCII(domain_value.GetString()), index);
+    }
+  }
+}
+
+ReferralHeadersMatcher::~ReferralHeadersMatcher() = default;
+
+const ReferralHeadersMatcher::Headers*
+ReferralHeadersMatcher::GetMatchingHeaders(const GURL& url) const {
+  if (domains_.empty() || !url.SchemeIsHTTPOrHTTPS())
+    return nullptr;
+
+  base::StringPiece host = url.host_piece();
+  if (!host.empty() && host.back() == '.')
+    host.remove_suffix(1);
+
+  // A domain matches its own host and all of its subdomains. Several
+  // entries can match at different levels, in which case the one listed
+  // first wins.
+  size_t match = headers_.size();
+  while (!host.empty()) {
+    const auto iter = domains_.find(host);
+    if (iter != domains_.end())
+      match = std::min(match, iter->second);
+
+    const size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    host.remove_prefix(dot + 1);
+  }
+
+  if (match == headers_.size())
+    return nullptr;
+  return &headers_[match];
+}
+
+}  // namespace brave
@@ -0,0 +1,58 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_MATCHER_H_
+#define BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_MATCHER_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+class GURL;
+
+namespace base {
+class ListValue;
+}  // namespace base
+
+namespace brave {
+
+// Compiled form of the referral headers list. Each entry of the list carries
+// a set of domains and the headers to send to them; the domains are indexed
+// by host so that matching a request only takes a lookup per label of its
+// host, without walking the list.
+class ReferralHeadersMatcher {
+ public:
+  using Headers = std::vector<std::pair<std::string, std::string>>;
+
+  explicit ReferralHeadersMatcher(const base::ListValue& referral_headers_list);
+  ~ReferralHeadersMatcher();
+
+  // Returns the headers of the first entry with a domain that matches the
+  // host of |url| or one of its parent domains, or nullptr if there is none.
+  // Only HTTP(S) URLs are matched.
+  const Headers* GetMatchingHeaders(const GURL& url) const;
+
+ private:
+  struct StringPieceLess {
+    using is_transparent = void;
+    bool operator()(base::StringPiece lhs, base::StringPiece rhs) const {
+      return lhs < rhs;
+    }
+  };
+
+  std::vector<Headers> headers_;
+  // Maps a domain to the index of the first entry in |headers_| listing it.
+  base::flat_map<std::string, size_t, StringPieceLess> domains_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReferralHeadersMatcher);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_MATCHER_H_
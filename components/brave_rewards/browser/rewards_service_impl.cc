@@ -427,9 +427,6 @@ void RewardsServiceImpl::StartLedger(StartProcessCallback callback) {
     return;
   }
 
-  ledger_database_.reset(
-      ledger::LedgerDatabase::CreateInstance(publisher_info_db_path_));
-
   BLOG(1, "Starting ledger process");
 
   if (!bat_ledger_service_.is_bound()) {
@@ -465,6 +462,13 @@ void RewardsServiceImpl::StartLedger(StartProcessCallback callback) {
     }
   }
 
+  if (ledger_process_database_) {
+    bat_ledger_service_->SetDatabasePath(publisher_info_db_path_);
+  } else {
+    ledger_database_.reset(
+        ledger::LedgerDatabase::CreateInstance(publisher_info_db_path_));
+  }
+
   bat_ledger_service_->Create(
       bat_ledger_client_receiver_.BindNewEndpointAndPassRemote(),
       bat_ledger_.BindNewEndpointAndPassReceiver(),
@@ -2490,7 +2494,19 @@ void RewardsServiceImpl::HandleFlags(const std::string& options) {
       } else {
         should_persist_logs_ = false;
       }
+
+      continue;
     }
+
+    // The database is opened by path, which the sandboxed ledger process
+    // can't do on Android
+#if !defined(OS_ANDROID)
+    if (name == "ledger-process-database") {
+      const std::string lower = base::ToLowerASCII(value);
+      ledger_process_database_ = lower == "true" || lower == "1";
+      continue;
+    }
+#endif
   }
 }
 
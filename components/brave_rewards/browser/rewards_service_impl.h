@@ -800,6 +800,9 @@ class RewardsServiceImpl : public RewardsService,
   bool ledger_for_testing_ = false;
   bool resetting_rewards_ = false;
   bool should_persist_logs_ = false;
+  // Database transactions are run by the ledger process on its own copy of
+  // the database connection, no |ledger_database_| is created
+  bool ledger_process_database_ = false;
 
   GetTestResponseCallback test_response_callback_;
 
@@ -6,6 +6,7 @@
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
 
 #include <algorithm>
+#include <atomic>
 #include <string>
 #include <utility>
 #include <vector>
@@ -100,6 +101,8 @@ std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
   return filter_option;
 }
 
+std::atomic<uint64_t> g_engine_generation(0);
+
 }  // namespace
 
 namespace brave_shields {
@@ -172,6 +175,7 @@ void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
       tags_.erase(it);
     }
   }
+  IncrementEngineGeneration();
 }
 
 void AdBlockBaseService::AddResources(const std::string& resources) {
@@ -184,6 +188,7 @@ void AdBlockBaseService::AddResources(const std::string& resources) {
 
   ad_block_client_->addResources(resources);
   resources_ = resources;
+  IncrementEngineGeneration();
 }
 
 bool AdBlockBaseService::TagExists(const std::string& tag) {
@@ -205,28 +210,36 @@ base::Optional<base::Value> AdBlockBaseService::HiddenClassIdSelectors(
       ad_block_client_->hiddenClassIdSelectors(classes, ids, exceptions));
 }
 
+// static
+uint64_t AdBlockBaseService::GetEngineGeneration() {
+  return g_engine_generation.load(std::memory_order_acquire);
+}
+
+// static
+void AdBlockBaseService::IncrementEngineGeneration() {
+  g_engine_generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
 void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path) {
   base::PostTaskAndReplyWithResult(
       FROM_HERE, {base::ThreadPool(), base::MayBlock()},
-      base::BindOnce(&brave_component_updater::LoadDATFileData<adblock::Engine>,
-                     dat_file_path),
+      base::BindOnce(
+          &brave_component_updater::LoadMappedDATFileData<adblock::Engine>,
+          dat_file_path),
       base::BindOnce(&AdBlockBaseService::OnGetDATFileData,
                      weak_factory_.GetWeakPtr()));
 }
 
-void AdBlockBaseService::OnGetDATFileData(GetDATFileDataResult result) {
-  if (result.second.empty()) {
-    LOG(ERROR) << "Could not obtain ad block data";
-    return;
-  }
-  if (!result.first.get()) {
-    LOG(ERROR) << "Failed to deserialize ad block data";
+void AdBlockBaseService::OnGetDATFileData(
+    std::unique_ptr<adblock::Engine> ad_block_client) {
+  if (!ad_block_client) {
+    LOG(ERROR) << "Failed to load ad block data";
     return;
   }
   GetTaskRunner()->PostTask(
       FROM_HERE, base::BindOnce(&AdBlockBaseService::UpdateAdBlockClient,
                                 base::Unretained(this),
-                                std::move(result.first)));
+                                std::move(ad_block_client)));
 }
 
 void AdBlockBaseService::UpdateAdBlockClient(
@@ -235,6 +248,7 @@ void AdBlockBaseService::UpdateAdBlockClient(
   ad_block_client_ = std::move(ad_block_client);
   AddKnownTagsToAdBlockInstance();
   AddKnownResourcesToAdBlockInstance();
+  IncrementEngineGeneration();
 }
 
 void AdBlockBaseService::AddKnownTagsToAdBlockInstance() {
@@ -261,6 +275,7 @@ void AdBlockBaseService::ResetForTest(const std::string& rules,
     resources_ = resources;
   }
   AddKnownResourcesToAdBlockInstance();
+  IncrementEngineGeneration();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -34,9 +34,6 @@ namespace brave_shields {
 // checking and init.
 class AdBlockBaseService : public BaseBraveShieldsService {
  public:
-  using GetDATFileDataResult =
-      brave_component_updater::LoadDATFileDataResult<adblock::Engine>;
-
   explicit AdBlockBaseService(BraveComponent::Delegate* delegate);
   ~AdBlockBaseService() override;
 
@@ -56,6 +53,12 @@ class AdBlockBaseService : public BaseBraveShieldsService {
           const std::vector<std::string>& ids,
           const std::vector<std::string>& exceptions);
 
+  // Returns a counter that changes whenever the rules of any ad-block engine
+  // are swapped or modified, so that results derived from the engines can be
+  // dropped. Safe to call from any thread.
+  static uint64_t GetEngineGeneration();
+  static void IncrementEngineGeneration();
+
  protected:
   friend class ::AdBlockServiceTest;
   bool Init() override;
@@ -70,7 +73,7 @@ class AdBlockBaseService : public BaseBraveShieldsService {
  private:
   void UpdateAdBlockClient(
       std::unique_ptr<adblock::Engine> ad_block_client);
-  void OnGetDATFileData(GetDATFileDataResult result);
+  void OnGetDATFileData(std::unique_ptr<adblock::Engine> ad_block_client);
   void OnPreferenceChanges(const std::string& pref_name);
 
   std::vector<std::string> tags_;
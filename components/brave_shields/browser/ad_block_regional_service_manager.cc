@@ -183,6 +183,7 @@ void AdBlockRegionalServiceManager::EnableFilterList(
       it->second->Unregister();
       regional_services_.erase(it);
     }
+    AdBlockBaseService::IncrementEngineGeneration();
   }
 
   // Update preferences to reflect enabled/disabled state of specified
@@ -15,6 +15,7 @@
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_restrictions.h"
 #include "brave/browser/brave_browser_process_impl.h"
@@ -27,6 +28,7 @@
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "url/gurl.h"
 
 #define DAT_FILE "rs-ABPFilterParserData.dat"
 #define REGIONAL_CATALOG "regional_catalog.json"
@@ -35,6 +37,11 @@ namespace brave_shields {
 
 namespace {
 
+// Number of urls whose merged url cosmetic resources are kept.
+constexpr size_t kUrlCosmeticResourcesCacheSize = 100;
+// Number of class/id batches whose merged selectors are kept.
+constexpr size_t kHiddenSelectorsCacheSize = 200;
+
 std::string GetTagFromPrefName(const std::string& pref_name) {
   if (pref_name == kFBEmbedControlType) {
     return brave_shields::kFacebookEmbeds;
@@ -123,10 +130,122 @@ AdBlockService::custom_filters_service() {
   return custom_filters_service_.get();
 }
 
+base::Optional<base::Value> AdBlockService::GetMergedUrlCosmeticResources(
+    const std::string& url) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  MaybeResetCosmeticCaches();
+
+  const GURL gurl(url);
+  if (!gurl.has_host()) {
+    base::Value resources = MergeUrlCosmeticResources(url);
+    if (resources.is_none())
+      return base::nullopt;
+    return resources;
+  }
+
+  // Exceptions like $generichide can be scoped to a path or even a query, so
+  // results are only shared between loads of the same url. The fragment
+  // never reaches the engines.
+  GURL::Replacements replacements;
+  replacements.ClearRef();
+  const std::string key = gurl.ReplaceComponents(replacements).spec();
+  auto it = url_cosmetic_resources_cache_.Get(key);
+  if (it == url_cosmetic_resources_cache_.end()) {
+    it = url_cosmetic_resources_cache_.Put(key,
+                                           MergeUrlCosmeticResources(url));
+  }
+  if (it->second.is_none())
+    return base::nullopt;
+  return it->second.Clone();
+}
+
+base::Value AdBlockService::GetMergedHiddenClassIdSelectors(
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids,
+    const std::vector<std::string>& exceptions) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  MaybeResetCosmeticCaches();
+
+  // Class names and ids cannot contain whitespace, so the joined lists are
+  // unambiguous.
+  const std::string key = base::JoinString(classes, " ") + "\n" +
+                          base::JoinString(ids, " ") + "\n" +
+                          base::JoinString(exceptions, "\n");
+  auto it = hidden_selectors_cache_.Get(key);
+  if (it == hidden_selectors_cache_.end()) {
+    it = hidden_selectors_cache_.Put(
+        key, MergeHiddenClassIdSelectors(classes, ids, exceptions));
+  }
+  return it->second.Clone();
+}
+
+base::Value AdBlockService::MergeUrlCosmeticResources(const std::string& url) {
+  base::Optional<base::Value> resources = UrlCosmeticResources(url);
+  if (!resources || !resources->is_dict())
+    return base::Value();
+
+  base::Optional<base::Value> regional_resources =
+      regional_service_manager()->UrlCosmeticResources(url);
+  if (regional_resources && regional_resources->is_dict()) {
+    MergeResourcesInto(std::move(*regional_resources), &*resources,
+                       /*force_hide=*/false);
+  }
+
+  base::Optional<base::Value> custom_resources =
+      custom_filters_service()->UrlCosmeticResources(url);
+  if (custom_resources && custom_resources->is_dict()) {
+    MergeResourcesInto(std::move(*custom_resources), &*resources,
+                       /*force_hide=*/true);
+  }
+
+  return std::move(*resources);
+}
+
+base::Value AdBlockService::MergeHiddenClassIdSelectors(
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids,
+    const std::vector<std::string>& exceptions) {
+  base::Optional<base::Value> hide_selectors =
+      HiddenClassIdSelectors(classes, ids, exceptions);
+  base::Optional<base::Value> regional_selectors =
+      regional_service_manager()->HiddenClassIdSelectors(classes, ids,
+                                                         exceptions);
+  base::Optional<base::Value> custom_selectors =
+      custom_filters_service()->HiddenClassIdSelectors(classes, ids,
+                                                       exceptions);
+
+  if (hide_selectors && hide_selectors->is_list()) {
+    if (regional_selectors && regional_selectors->is_list()) {
+      for (auto& selector : regional_selectors->GetList())
+        hide_selectors->Append(std::move(selector));
+    }
+  } else {
+    hide_selectors = std::move(regional_selectors);
+  }
+
+  base::Value result(base::Value::Type::LIST);
+  if (hide_selectors && hide_selectors->is_list())
+    result.Append(std::move(*hide_selectors));
+  if (custom_selectors && custom_selectors->is_list())
+    result.Append(std::move(*custom_selectors));
+  return result;
+}
+
+void AdBlockService::MaybeResetCosmeticCaches() {
+  const uint64_t generation = GetEngineGeneration();
+  if (generation == cosmetic_caches_generation_)
+    return;
+  url_cosmetic_resources_cache_.Clear();
+  hidden_selectors_cache_.Clear();
+  cosmetic_caches_generation_ = generation;
+}
+
 AdBlockService::AdBlockService(
     brave_component_updater::BraveComponent::Delegate* delegate)
     : AdBlockBaseService(delegate),
-      component_delegate_(delegate) {
+      component_delegate_(delegate),
+      url_cosmetic_resources_cache_(kUrlCosmeticResourcesCacheSize),
+      hidden_selectors_cache_(kHiddenSelectorsCacheSize) {
 }
 
 AdBlockService::~AdBlockService() {}
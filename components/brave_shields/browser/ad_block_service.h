@@ -12,6 +12,9 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
+#include "base/optional.h"
+#include "base/values.h"
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
 #include "components/keyed_service/core/keyed_service.h"
 #include "components/prefs/pref_registry_simple.h"
@@ -55,6 +58,17 @@ class AdBlockService : public AdBlockBaseService {
   AdBlockRegionalServiceManager* regional_service_manager();
   AdBlockCustomFiltersService* custom_filters_service();
 
+  // Cosmetic filtering results merged from the default, regional and custom
+  // engines. Merged url resources are cached per url and merged selectors
+  // per class/id batch; both caches are dropped as soon as any engine
+  // changes. Must be called on the ad-block task runner.
+  base::Optional<base::Value> GetMergedUrlCosmeticResources(
+      const std::string& url);
+  base::Value GetMergedHiddenClassIdSelectors(
+      const std::vector<std::string>& classes,
+      const std::vector<std::string>& ids,
+      const std::vector<std::string>& exceptions);
+
  protected:
   bool Init() override;
   void OnComponentReady(const std::string& component_id,
@@ -72,6 +86,13 @@ class AdBlockService : public AdBlockBaseService {
       const std::string& component_id,
       const std::string& component_base64_public_key);
 
+  base::Value MergeUrlCosmeticResources(const std::string& url);
+  base::Value MergeHiddenClassIdSelectors(
+      const std::vector<std::string>& classes,
+      const std::vector<std::string>& ids,
+      const std::vector<std::string>& exceptions);
+  void MaybeResetCosmeticCaches();
+
   std::unique_ptr<brave_shields::AdBlockRegionalServiceManager>
       regional_service_manager_;
   std::unique_ptr<brave_shields::AdBlockCustomFiltersService>
@@ -79,6 +100,11 @@ class AdBlockService : public AdBlockBaseService {
 
   BraveComponent::Delegate* component_delegate_;
 
+  // Accessed only on the ad-block task runner.
+  base::MRUCache<std::string, base::Value> url_cosmetic_resources_cache_;
+  base::MRUCache<std::string, base::Value> hidden_selectors_cache_;
+  uint64_t cosmetic_caches_generation_ = 0;
+
   base::WeakPtrFactory<AdBlockService> weak_factory_{this};
   DISALLOW_COPY_AND_ASSIGN(AdBlockService);
 };
@@ -5,13 +5,18 @@
 
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 
+#include <array>
 #include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
+#include "base/memory/ref_counted.h"
+#include "base/no_destructor.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/synchronization/lock.h"
 #include "brave/common/pref_names.h"
 #include "brave/common/render_messages.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
@@ -98,38 +103,128 @@ WebContents* GetWebContents(
   return web_contents;
 }
 
-}  // namespace
+// How long blocked events of a tab are coalesced before being dispatched,
+// unless overridden for testing.
+constexpr int kDefaultBlockedEventsFlushDelayMs = 200;
+base::TimeDelta g_blocked_events_flush_delay =
+    base::TimeDelta::FromMilliseconds(kDefaultBlockedEventsFlushDelayMs);
+
+// Upper bound of the blocked subresources remembered for a page.
+constexpr size_t kMaxBlockedSubresources = 1000;
+
+const char* GetBlockedCountPrefName(const std::string& block_type) {
+  if (block_type == brave_shields::kAds)
+    return kAdsBlocked;
+  if (block_type == brave_shields::kHTTPUpgradableResources)
+    return kHttpsUpgrades;
+  if (block_type == brave_shields::kJavaScript)
+    return kJavascriptBlocked;
+  if (block_type == brave_shields::kFingerprintingV2)
+    return kFingerprintingBlocked;
+  return nullptr;
+}
 
-namespace brave_shields {
+// Maps a frame to the URL of its tab. Written on the UI thread only, and read
+// for network requests, on whichever thread builds their BraveRequestInfo.
+//
+// Entries are spread over shards, each of which publishes an immutable
+// snapshot: the UI thread builds an updated copy of a shard and swaps it in,
+// so a lookup only holds a shard lock for as long as it takes to grab a
+// reference to the current snapshot, never while the UI thread updates it.
+template <typename Key>
+class FrameTabUrlMap {
+ public:
+  FrameTabUrlMap() {
+    for (auto& shard : shards_)
+      shard.snapshot = base::MakeRefCounted<Snapshot>();
+  }
+
+  GURL Get(const Key& key) const {
+    const Shard& shard = GetShard(key);
+    scoped_refptr<const Snapshot> snapshot;
+    {
+      base::AutoLock lock(shard.lock);
+      snapshot = shard.snapshot;
+    }
+    auto iter = snapshot->data.find(key);
+    return iter != snapshot->data.end() ? iter->second : GURL();
+  }
 
-base::Lock BraveShieldsWebContentsObserver::frame_data_map_lock_;
-std::map<BraveShieldsWebContentsObserver::RenderFrameIdKey, GURL>
-    BraveShieldsWebContentsObserver::frame_key_to_tab_url_;
-std::map<int, GURL>
-    BraveShieldsWebContentsObserver::frame_tree_node_id_to_tab_url_;
+  void Set(const Key& key, const GURL& url) {
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    Shard& shard = GetShard(key);
+    // Only the UI thread swaps snapshots, so the current one can be read here
+    // without the lock.
+    auto iter = shard.snapshot->data.find(key);
+    if (iter != shard.snapshot->data.end() && iter->second == url)
+      return;
+    auto updated = base::MakeRefCounted<Snapshot>(shard.snapshot->data);
+    updated->data[key] = url;
+    Publish(&shard, std::move(updated));
+  }
 
-BraveShieldsWebContentsObserver::RenderFrameIdKey::RenderFrameIdKey()
-    : render_process_id(content::ChildProcessHost::kInvalidUniqueID),
-      frame_routing_id(MSG_ROUTING_NONE) {}
+  void Erase(const Key& key) {
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    Shard& shard = GetShard(key);
+    if (!shard.snapshot->data.count(key))
+      return;
+    auto updated = base::MakeRefCounted<Snapshot>(shard.snapshot->data);
+    updated->data.erase(key);
+    Publish(&shard, std::move(updated));
+  }
 
-BraveShieldsWebContentsObserver::RenderFrameIdKey::RenderFrameIdKey(
-    int render_process_id,
-    int frame_routing_id)
-    : render_process_id(render_process_id),
-      frame_routing_id(frame_routing_id) {}
-
-bool BraveShieldsWebContentsObserver::RenderFrameIdKey::operator<(
-    const RenderFrameIdKey& other) const {
-  return std::tie(render_process_id, frame_routing_id) <
-         std::tie(other.render_process_id, other.frame_routing_id);
+ private:
+  using Snapshot = base::RefCountedData<base::flat_map<Key, GURL>>;
+
+  struct Shard {
+    mutable base::Lock lock;
+    scoped_refptr<const Snapshot> snapshot;
+  };
+
+  static constexpr size_t kShardCount = 16;
+
+  static size_t GetShardIndex(int key) {
+    return static_cast<unsigned>(key) % kShardCount;
+  }
+  static size_t GetShardIndex(const std::pair<int, int>& key) {
+    return (static_cast<unsigned>(key.first) * 31u +
+            static_cast<unsigned>(key.second)) % kShardCount;
+  }
+
+  const Shard& GetShard(const Key& key) const {
+    return shards_[GetShardIndex(key)];
+  }
+  Shard& GetShard(const Key& key) { return shards_[GetShardIndex(key)]; }
+
+  static void Publish(Shard* shard, scoped_refptr<const Snapshot> snapshot) {
+    // The previous snapshot is released outside of the lock, it may be the
+    // last reference to it.
+    base::AutoLock lock(shard->lock);
+    shard->snapshot.swap(snapshot);
+  }
+
+  std::array<Shard, kShardCount> shards_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameTabUrlMap);
+};
+
+// Keyed by (render process id, frame routing id).
+using RenderFrameIdKey = std::pair<int, int>;
+
+FrameTabUrlMap<RenderFrameIdKey>& GetFrameKeyToTabUrlMap() {
+  static base::NoDestructor<FrameTabUrlMap<RenderFrameIdKey>> map;
+  return *map;
 }
 
-bool BraveShieldsWebContentsObserver::RenderFrameIdKey::operator==(
-    const RenderFrameIdKey& other) const {
-  return render_process_id == other.render_process_id &&
-         frame_routing_id == other.frame_routing_id;
+FrameTabUrlMap<int>& GetFrameTreeNodeIdToTabUrlMap() {
+  static base::NoDestructor<FrameTabUrlMap<int>> map;
+  return *map;
 }
 
+}  // namespace
+
+namespace brave_shields {
+
 BraveShieldsWebContentsObserver::~BraveShieldsWebContentsObserver() {
 }
 
@@ -149,20 +244,18 @@ void BraveShieldsWebContentsObserver::RenderFrameCreated(
   if (web_contents) {
     UpdateContentSettingsToRendererFrames(web_contents);
 
-    base::AutoLock lock(frame_data_map_lock_);
     const RenderFrameIdKey key(rfh->GetProcess()->GetID(), rfh->GetRoutingID());
-    frame_key_to_tab_url_[key] = web_contents->GetURL();
-    frame_tree_node_id_to_tab_url_[rfh->GetFrameTreeNodeId()] =
-        web_contents->GetURL();
+    GetFrameKeyToTabUrlMap().Set(key, web_contents->GetURL());
+    GetFrameTreeNodeIdToTabUrlMap().Set(rfh->GetFrameTreeNodeId(),
+                                        web_contents->GetURL());
   }
 }
 
 void BraveShieldsWebContentsObserver::RenderFrameDeleted(
     RenderFrameHost* rfh) {
-  base::AutoLock lock(frame_data_map_lock_);
   const RenderFrameIdKey key(rfh->GetProcess()->GetID(), rfh->GetRoutingID());
-  frame_key_to_tab_url_.erase(key);
-  frame_tree_node_id_to_tab_url_.erase(rfh->GetFrameTreeNodeId());
+  GetFrameKeyToTabUrlMap().Erase(key);
+  GetFrameTreeNodeIdToTabUrlMap().Erase(rfh->GetFrameTreeNodeId());
 }
 
 void BraveShieldsWebContentsObserver::RenderFrameHostChanged(
@@ -185,39 +278,115 @@ void BraveShieldsWebContentsObserver::DidFinishNavigation(
   int routing_id = main_frame->GetRoutingID();
   int tree_node_id = main_frame->GetFrameTreeNodeId();
 
-  base::AutoLock lock(frame_data_map_lock_);
-  frame_key_to_tab_url_[{process_id, routing_id}] = web_contents()->GetURL();
-  frame_tree_node_id_to_tab_url_[tree_node_id] = web_contents()->GetURL();
+  GetFrameKeyToTabUrlMap().Set({process_id, routing_id},
+                               web_contents()->GetURL());
+  GetFrameTreeNodeIdToTabUrlMap().Set(tree_node_id, web_contents()->GetURL());
+}
+
+void BraveShieldsWebContentsObserver::WebContentsDestroyed() {
+  FlushBlockedEvents();
 }
 
 // static
 GURL BraveShieldsWebContentsObserver::GetTabURLFromRenderFrameInfo(
     int render_process_id, int render_frame_id, int render_frame_tree_node_id) {
-  base::AutoLock lock(frame_data_map_lock_);
   if (-1 != render_process_id && -1 != render_frame_id) {
-    auto iter = frame_key_to_tab_url_.find({render_process_id,
-                                            render_frame_id});
-    if (iter != frame_key_to_tab_url_.end()) {
-      return iter->second;
+    GURL tab_url = GetFrameKeyToTabUrlMap().Get(
+        {render_process_id, render_frame_id});
+    if (!tab_url.is_empty()) {
+      return tab_url;
     }
   }
   if (-1 != render_frame_tree_node_id) {
-    auto iter2 = frame_tree_node_id_to_tab_url_.find(render_frame_tree_node_id);
-    if (iter2 != frame_tree_node_id_to_tab_url_.end()) {
-      return iter2->second;
-    }
+    return GetFrameTreeNodeIdToTabUrlMap().Get(render_frame_tree_node_id);
   }
   return GURL();
 }
 
 bool BraveShieldsWebContentsObserver::IsBlockedSubresource(
     const std::string& subresource) {
-  return blocked_url_paths_.find(subresource) != blocked_url_paths_.end();
+  // Once the bound is reached, every subresource is treated as already seen,
+  // so that the page can't inflate the blocked counters by loading the same
+  // URLs over and over.
+  return blocked_url_paths_.size() >= kMaxBlockedSubresources ||
+         blocked_url_paths_.find(subresource) != blocked_url_paths_.end();
 }
 
 void BraveShieldsWebContentsObserver::AddBlockedSubresource(
     const std::string& subresource) {
-  blocked_url_paths_.insert(subresource);
+  if (blocked_url_paths_.size() < kMaxBlockedSubresources)
+    blocked_url_paths_.insert(subresource);
+}
+
+// static
+size_t BraveShieldsWebContentsObserver::GetMaxBlockedSubresourcesForTesting() {
+  return kMaxBlockedSubresources;
+}
+
+// static
+base::TimeDelta
+BraveShieldsWebContentsObserver::GetDefaultBlockedEventsFlushDelayForTesting() {
+  return base::TimeDelta::FromMilliseconds(kDefaultBlockedEventsFlushDelayMs);
+}
+
+// static
+void BraveShieldsWebContentsObserver::SetBlockedEventsFlushDelayForTesting(
+    base::TimeDelta delay) {
+  g_blocked_events_flush_delay = delay;
+}
+
+void BraveShieldsWebContentsObserver::AddBlockedEvent(
+    const std::string& block_type,
+    const std::string& subresource) {
+  pending_blocked_events_[block_type].push_back(subresource);
+  ScheduleFlush();
+}
+
+void BraveShieldsWebContentsObserver::CountBlockedEvent(
+    const std::string& block_type) {
+  const char* pref_name = GetBlockedCountPrefName(block_type);
+  if (!pref_name)
+    return;
+  pending_blocked_counts_[pref_name]++;
+  ScheduleFlush();
+}
+
+void BraveShieldsWebContentsObserver::ScheduleFlush() {
+  if (g_blocked_events_flush_delay.is_zero()) {
+    FlushBlockedEvents();
+    return;
+  }
+  if (!flush_timer_.IsRunning()) {
+    flush_timer_.Start(FROM_HERE, g_blocked_events_flush_delay, this,
+                       &BraveShieldsWebContentsObserver::FlushBlockedEvents);
+  }
+}
+
+void BraveShieldsWebContentsObserver::FlushBlockedEvents() {
+  flush_timer_.Stop();
+  if (!web_contents()) {
+    pending_blocked_events_.clear();
+    pending_blocked_counts_.clear();
+    return;
+  }
+
+  for (const auto& pending : pending_blocked_events_) {
+    DispatchBlockedEventsForWebContents(pending.first, pending.second,
+                                        web_contents());
+  }
+  pending_blocked_events_.clear();
+
+  if (pending_blocked_counts_.empty())
+    return;
+  PrefService* prefs = Profile::FromBrowserContext(
+      web_contents()->GetBrowserContext())->
+      GetOriginalProfile()->
+      GetPrefs();
+  for (const auto& count : pending_blocked_counts_) {
+    prefs->SetUint64(count.first,
+                     prefs->GetUint64(count.first) + count.second);
+  }
+  pending_blocked_counts_.clear();
 }
 
 // static
@@ -231,38 +400,30 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
 
   WebContents* web_contents = GetWebContents(render_process_id,
     render_frame_id, frame_tree_node_id);
-  DispatchBlockedEventForWebContents(block_type, subresource, web_contents);
+  if (!web_contents) {
+    return;
+  }
 
-  if (web_contents) {
-    BraveShieldsWebContentsObserver* observer =
-        BraveShieldsWebContentsObserver::FromWebContents(web_contents);
-    if (observer &&
-        !observer->IsBlockedSubresource(subresource)) {
-      observer->AddBlockedSubresource(subresource);
-      PrefService* prefs = Profile::FromBrowserContext(
-          web_contents->GetBrowserContext())->
-          GetOriginalProfile()->
-          GetPrefs();
-
-      if (block_type == kAds) {
-        prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
-      } else if (block_type == kHTTPUpgradableResources) {
-        prefs->SetUint64(kHttpsUpgrades, prefs->GetUint64(kHttpsUpgrades) + 1);
-      } else if (block_type == kJavaScript) {
-        prefs->SetUint64(kJavascriptBlocked,
-            prefs->GetUint64(kJavascriptBlocked) + 1);
-      } else if (block_type == kFingerprintingV2) {
-        prefs->SetUint64(kFingerprintingBlocked,
-            prefs->GetUint64(kFingerprintingBlocked) + 1);
-      }
-    }
+  BraveShieldsWebContentsObserver* observer =
+      BraveShieldsWebContentsObserver::FromWebContents(web_contents);
+  if (!observer) {
+    DispatchBlockedEventsForWebContents(block_type, {subresource},
+                                        web_contents);
+    return;
+  }
+
+  if (!observer->IsBlockedSubresource(subresource)) {
+    observer->AddBlockedSubresource(subresource);
+    observer->CountBlockedEvent(block_type);
   }
+  observer->AddBlockedEvent(block_type, subresource);
 }
 
 #if !defined(OS_ANDROID)
 // static
-void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
-    const std::string& block_type, const std::string& subresource,
+void BraveShieldsWebContentsObserver::DispatchBlockedEventsForWebContents(
+    const std::string& block_type,
+    const std::vector<std::string>& subresources,
     WebContents* web_contents) {
 #if BUILDFLAG(ENABLE_EXTENSIONS)
   if (!web_contents) {
@@ -275,7 +436,7 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
     extensions::api::brave_shields::OnBlocked::Details details;
     details.tab_id = extensions::ExtensionTabUtil::GetTabId(web_contents);
     details.block_type = block_type;
-    details.subresource = subresource;
+    details.subresources = subresources;
     std::unique_ptr<base::ListValue> args(
         extensions::api::brave_shields::OnBlocked::Create(details)
           .release());
@@ -306,25 +467,14 @@ bool BraveShieldsWebContentsObserver::OnMessageReceived(
 void BraveShieldsWebContentsObserver::OnJavaScriptBlockedWithDetail(
     RenderFrameHost* render_frame_host,
     const base::string16& details) {
-  WebContents* web_contents =
-      WebContents::FromRenderFrameHost(render_frame_host);
-  if (!web_contents) {
-    return;
-  }
-  DispatchBlockedEventForWebContents(brave_shields::kJavaScript,
-      base::UTF16ToUTF8(details), web_contents);
+  AddBlockedEvent(brave_shields::kJavaScript, base::UTF16ToUTF8(details));
 }
 
 void BraveShieldsWebContentsObserver::OnFingerprintingBlockedWithDetail(
     RenderFrameHost* render_frame_host,
     const base::string16& details) {
-  WebContents* web_contents =
-      WebContents::FromRenderFrameHost(render_frame_host);
-  if (!web_contents) {
-    return;
-  }
-  DispatchBlockedEventForWebContents(brave_shields::kFingerprintingV2,
-      base::UTF16ToUTF8(details), web_contents);
+  AddBlockedEvent(brave_shields::kFingerprintingV2,
+                  base::UTF16ToUTF8(details));
 }
 
 // static
@@ -343,6 +493,8 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
   if (navigation_handle->IsInMainFrame() &&
       !navigation_handle->IsSameDocument() &&
       navigation_handle->GetReloadType() == content::ReloadType::NONE) {
+    // Events of the previous page must not be attributed to the new one.
+    FlushBlockedEvents();
     allowed_script_origins_.clear();
     blocked_url_paths_.clear();
   }
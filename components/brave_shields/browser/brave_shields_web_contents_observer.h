@@ -6,14 +6,17 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BRAVE_SHIELDS_WEB_CONTENTS_OBSERVER_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BRAVE_SHIELDS_WEB_CONTENTS_OBSERVER_H_
 
+#include <stdint.h>
+
 #include <map>
 #include <set>
 #include <string>
 #include <vector>
 
 #include "base/macros.h"
-#include "base/synchronization/lock.h"
 #include "base/strings/string16.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
 
@@ -32,9 +35,9 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
   ~BraveShieldsWebContentsObserver() override;
 
   static void RegisterProfilePrefs(PrefRegistrySimple* registry);
-  static void DispatchBlockedEventForWebContents(
+  static void DispatchBlockedEventsForWebContents(
       const std::string& block_type,
-      const std::string& subresource,
+      const std::vector<std::string>& subresources,
       content::WebContents* web_contents);
   static void DispatchBlockedEvent(
       std::string block_type,
@@ -49,22 +52,14 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
   bool IsBlockedSubresource(const std::string& subresource);
   void AddBlockedSubresource(const std::string& subresource);
 
- protected:
-    // A set of identifiers that uniquely identifies a RenderFrame.
-  struct RenderFrameIdKey {
-    RenderFrameIdKey();
-    RenderFrameIdKey(int render_process_id, int frame_routing_id);
-
-    // The process ID of the renderer that contains the RenderFrame.
-    int render_process_id;
-
-    // The routing ID of the RenderFrame.
-    int frame_routing_id;
-
-    bool operator<(const RenderFrameIdKey& other) const;
-    bool operator==(const RenderFrameIdKey& other) const;
-  };
+  // Blocked events are coalesced for |delay| before being dispatched; a zero
+  // delay dispatches them, and commits the blocked counters, right away.
+  static void SetBlockedEventsFlushDelayForTesting(base::TimeDelta delay);
+  static base::TimeDelta GetDefaultBlockedEventsFlushDelayForTesting();
+  // Number of distinct blocked subresources counted for a page.
+  static size_t GetMaxBlockedSubresourcesForTesting();
 
+ protected:
   // content::WebContentsObserver overrides.
   void RenderFrameCreated(content::RenderFrameHost* host) override;
   void RenderFrameDeleted(content::RenderFrameHost* render_frame_host) override;
@@ -74,6 +69,7 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
       content::NavigationHandle* navigation_handle) override;
   void DidFinishNavigation(
       content::NavigationHandle* navigation_handle) override;
+  void WebContentsDestroyed() override;
 
   // Invoked if an IPC message is coming from a specific RenderFrameHost.
   bool OnMessageReceived(const IPC::Message& message,
@@ -85,19 +81,25 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
       content::RenderFrameHost* render_frame_host,
       const base::string16& details);
 
-  // TODO(iefremov): Refactor this away or at least put into base::NoDestructor.
-  // Protects global maps below from being concurrently written on the UI thread
-  // and read on the IO thread.
-  static base::Lock frame_data_map_lock_;
-  static std::map<RenderFrameIdKey, GURL> frame_key_to_tab_url_;
-  static std::map<int, GURL> frame_tree_node_id_to_tab_url_;
-
  private:
   friend class content::WebContentsUserData<BraveShieldsWebContentsObserver>;
+
+  void AddBlockedEvent(const std::string& block_type,
+                       const std::string& subresource);
+  void CountBlockedEvent(const std::string& block_type);
+  void ScheduleFlush();
+  void FlushBlockedEvents();
+
   std::vector<std::string> allowed_script_origins_;
-  // We keep a set of the current page's blocked URLs in case the page
-  // continually tries to load the same blocked URLs.
+  // We keep a bounded set of the current page's blocked URLs in case the page
+  // continually tries to load the same blocked URLs. Once it is full, blocked
+  // URLs are no longer counted for the rest of the page.
   std::set<std::string> blocked_url_paths_;
+  // Blocked subresources not dispatched yet, by block type.
+  std::map<std::string, std::vector<std::string>> pending_blocked_events_;
+  // Blocked counter increments not committed to prefs yet, by pref name.
+  std::map<std::string, uint64_t> pending_blocked_counts_;
+  base::OneShotTimer flush_timer_;
 
   WEB_CONTENTS_USER_DATA_KEY_DECL();
   DISALLOW_COPY_AND_ASSIGN(BraveShieldsWebContentsObserver);
@@ -6,6 +6,7 @@
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 
 #include <string>
+#include <vector>
 
 #include "brave/browser/android/brave_shields_content_settings.h"
 #include "chrome/browser/android/tab_android.h"
@@ -16,8 +17,9 @@ using content::WebContents;
 
 namespace brave_shields {
 // static
-void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
-    const std::string& block_type, const std::string& subresource,
+void BraveShieldsWebContentsObserver::DispatchBlockedEventsForWebContents(
+    const std::string& block_type,
+    const std::vector<std::string>& subresources,
     WebContents* web_contents) {
   if (!web_contents) {
     return;
@@ -29,8 +31,10 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
   if (tab) {
     tabId = tab->GetAndroidId();
   }
-  chrome::android::BraveShieldsContentSettings::DispatchBlockedEvent(
-      tabId, block_type, subresource);
+  for (const auto& subresource : subresources) {
+    chrome::android::BraveShieldsContentSettings::DispatchBlockedEvent(
+        tabId, block_type, subresource);
+  }
 }
 
 }  // namespace brave_shields
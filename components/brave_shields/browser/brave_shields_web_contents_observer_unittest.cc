@@ -0,0 +1,71 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "brave/common/pref_names.h"
+#include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "chrome/browser/profiles/profile.h"
+#include "chrome/test/base/chrome_render_view_host_test_harness.h"
+#include "components/prefs/pref_service.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+class BraveShieldsWebContentsObserverTest
+    : public ChromeRenderViewHostTestHarness {
+ public:
+  void SetUp() override {
+    ChromeRenderViewHostTestHarness::SetUp();
+    BraveShieldsWebContentsObserver::SetBlockedEventsFlushDelayForTesting(
+        base::TimeDelta());
+    BraveShieldsWebContentsObserver::CreateForWebContents(web_contents());
+  }
+
+  void TearDown() override {
+    BraveShieldsWebContentsObserver::SetBlockedEventsFlushDelayForTesting(
+        BraveShieldsWebContentsObserver::
+            GetDefaultBlockedEventsFlushDelayForTesting());
+    ChromeRenderViewHostTestHarness::TearDown();
+  }
+
+  void DispatchBlockedAd(const std::string& subresource) {
+    BraveShieldsWebContentsObserver::DispatchBlockedEvent(
+        kAds, subresource, main_rfh()->GetProcess()->GetID(),
+        main_rfh()->GetRoutingID(), main_rfh()->GetFrameTreeNodeId());
+  }
+
+  uint64_t GetAdsBlocked() {
+    return profile()->GetPrefs()->GetUint64(kAdsBlocked);
+  }
+};
+
+TEST_F(BraveShieldsWebContentsObserverTest, RepeatedSubresourceCountedOnce) {
+  DispatchBlockedAd("https://ads.example.com/1.js");
+  DispatchBlockedAd("https://ads.example.com/1.js");
+  DispatchBlockedAd("https://ads.example.com/2.js");
+  EXPECT_EQ(2ULL, GetAdsBlocked());
+}
+
+TEST_F(BraveShieldsWebContentsObserverTest, CountingStopsAtBound) {
+  const size_t max_blocked_subresources =
+      BraveShieldsWebContentsObserver::GetMaxBlockedSubresourcesForTesting();
+  for (size_t i = 0; i < max_blocked_subresources; ++i)
+    DispatchBlockedAd("https://ads.example.com/" + base::NumberToString(i));
+  EXPECT_EQ(max_blocked_subresources, GetAdsBlocked());
+
+  // Neither repeated nor new subresources are counted once the set is full.
+  DispatchBlockedAd("https://ads.example.com/0");
+  DispatchBlockedAd("https://ads.example.com/new");
+  EXPECT_EQ(max_blocked_subresources, GetAdsBlocked());
+}
+
+}  // namespace brave_shields
@@ -14,5 +14,11 @@ const base::Feature kBraveAdblockCosmeticFiltering{
     "BraveAdblockCosmeticFiltering",
     base::FEATURE_ENABLED_BY_DEFAULT};
 
+// Applies cosmetic filters from a renderer-side agent talking to the browser
+// over mojo, instead of the Brave extension content script.
+const base::Feature kBraveNativeCosmeticFiltering{
+    "BraveNativeCosmeticFiltering",
+    base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace features
 }  // namespace brave_shields
@@ -0,0 +1,379 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/renderer/cosmetic_filters_agent.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/stl_util.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "content/public/renderer/render_frame.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
+#include "third_party/blink/public/platform/web_string.h"
+#include "third_party/blink/public/platform/web_url.h"
+#include "third_party/blink/public/platform/web_vector.h"
+#include "third_party/blink/public/web/web_element.h"
+#include "third_party/blink/public/web/web_local_frame.h"
+#include "third_party/blink/public/web/web_node.h"
+#include "third_party/blink/public/web/web_script_source.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+namespace {
+
+// Generic selectors are checked for first party content this many times
+// before they are left hidden for good.
+constexpr int kMaxFirstPartyChecks = 3;
+
+// The cutoff for first party text ads: anything with less text is not
+// considered an ad.
+constexpr size_t kMinAdTextChars = 30;
+constexpr size_t kMinAdTextWords = 5;
+
+// Generic hiding is not applied on these search engines.
+constexpr const char* kVettedSearchEngines[] = {
+    "duckduckgo", "qwant", "bing", "startpage",
+    "yahoo", "onesearch", "google", "yandex",
+};
+
+// Ids only ever used by third party ads.
+constexpr const char* kThirdPartyAdIdPrefixes[] = {
+    "google_ads_iframe_", "div-gpt-ad", "adfox_",
+};
+
+// Returns the next node of a pre-order traversal of the subtree at |root|.
+blink::WebNode NextNode(blink::WebNode node, const blink::WebNode& root) {
+  blink::WebNode child = node.FirstChild();
+  if (!child.IsNull())
+    return child;
+  while (!node.IsNull() && node != root) {
+    blink::WebNode sibling = node.NextSibling();
+    if (!sibling.IsNull())
+      return sibling;
+    node = node.ParentNode();
+  }
+  return blink::WebNode();
+}
+
+bool IsVettedSearchEngine(const GURL& url) {
+  const std::string domain =
+      net::registry_controlled_domains::GetDomainAndRegistry(
+          url, net::registry_controlled_domains::EXCLUDE_PRIVATE_REGISTRIES);
+  const std::string label = domain.substr(0, domain.find('.'));
+  for (const char* search_engine : kVettedSearchEngines) {
+    if (label == search_engine)
+      return true;
+  }
+  return false;
+}
+
+bool IsFirstPartyUrl(const blink::WebDocument& document,
+                     const std::string& url) {
+  if (!base::StartsWith(url, "//", base::CompareCase::SENSITIVE) &&
+      !base::StartsWith(url, "http://", base::CompareCase::SENSITIVE) &&
+      !base::StartsWith(url, "https://", base::CompareCase::SENSITIVE)) {
+    return true;
+  }
+  return net::registry_controlled_domains::SameDomainOrHost(
+      GURL(document.CompleteURL(blink::WebString::FromUTF8(url))),
+      GURL(document.Url()),
+      net::registry_controlled_domains::EXCLUDE_PRIVATE_REGISTRIES);
+}
+
+bool IsTextAd(const std::string& text) {
+  const base::StringPiece trimmed =
+      base::TrimWhitespaceASCII(text, base::TRIM_ALL);
+  if (trimmed.size() < kMinAdTextChars)
+    return false;
+  return base::SplitStringPiece(trimmed, " ", base::KEEP_WHITESPACE,
+                                base::SPLIT_WANT_ALL).size() >=
+         kMinAdTextWords;
+}
+
+// Whether the subtree at |root| looks like first party content: it either
+// loads a first party resource, or loads no remote resource at all and holds
+// a non-trivial amount of text.
+bool IsSubtreeFirstParty(const blink::WebDocument& document,
+                         const blink::WebElement& root) {
+  bool found_third_party_resource = false;
+  for (blink::WebNode node = root; !node.IsNull(); node = NextNode(node, root)) {
+    if (!node.IsElementNode())
+      continue;
+    const blink::WebElement element = node.To<blink::WebElement>();
+
+    const std::string id = element.GetAttribute("id").Utf8();
+    for (const char* prefix : kThirdPartyAdIdPrefixes) {
+      if (base::StartsWith(id, prefix, base::CompareCase::SENSITIVE))
+        return false;
+    }
+
+    if (element.HasAttribute("src")) {
+      if (IsFirstPartyUrl(document, element.GetAttribute("src").Utf8()))
+        return true;
+      found_third_party_resource = true;
+    }
+
+    if (element.HasAttribute("style")) {
+      const std::string style = element.GetAttribute("style").Utf8();
+      if (style.find("url(") != std::string::npos ||
+          style.find("//") != std::string::npos) {
+        found_third_party_resource = true;
+      }
+    }
+
+    if (element.HasAttribute("srcdoc") &&
+        base::TrimWhitespaceASCII(element.GetAttribute("srcdoc").Utf8(),
+                                  base::TRIM_ALL).empty()) {
+      found_third_party_resource = true;
+    }
+  }
+
+  if (found_third_party_resource || root.HasHTMLTagName("script"))
+    return false;
+  return IsTextAd(root.TextContent().Utf8());
+}
+
+std::string HideRules(const std::vector<std::string>& selectors) {
+  // One rule per selector, so that an invalid selector only drops itself.
+  std::string css;
+  for (const auto& selector : selectors)
+    css += selector + "{display:none !important;}\n";
+  return css;
+}
+
+}  // namespace
+
+CosmeticFiltersAgent::CosmeticFiltersAgent(content::RenderFrame* render_frame)
+    : content::RenderFrameObserver(render_frame) {}
+
+CosmeticFiltersAgent::~CosmeticFiltersAgent() {}
+
+void CosmeticFiltersAgent::DidCreateDocumentElement() {
+  ResetDocumentState();
+
+  if (!GURL(GetDocument().Url()).SchemeIsHTTPOrHTTPS())
+    return;
+
+  GetCosmeticFiltersResources()->GetUrlCosmeticResources(
+      base::BindOnce(&CosmeticFiltersAgent::OnGetUrlCosmeticResources,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void CosmeticFiltersAgent::DidFinishDocumentLoad() {
+  document_loaded_ = true;
+  QueryNewClassIdSelectors();
+}
+
+void CosmeticFiltersAgent::DidFinishLoad() {
+  QueryNewClassIdSelectors();
+  CheckFirstPartySelectors();
+}
+
+void CosmeticFiltersAgent::OnDestruct() {
+  delete this;
+}
+
+mojom::CosmeticFiltersResources*
+CosmeticFiltersAgent::GetCosmeticFiltersResources() {
+  if (!cosmetic_filters_resources_) {
+    render_frame()->GetRemoteAssociatedInterfaces()->GetInterface(
+        &cosmetic_filters_resources_);
+  }
+  return cosmetic_filters_resources_.get();
+}
+
+void CosmeticFiltersAgent::ResetDocumentState() {
+  // Replies for the previous document must not touch the new one.
+  weak_factory_.InvalidateWeakPtrs();
+  resources_received_ = false;
+  document_loaded_ = false;
+  hide_first_party_content_ = false;
+  generichide_ = false;
+  skip_generic_selectors_ = false;
+  exceptions_.clear();
+  queried_classes_.clear();
+  queried_ids_.clear();
+  known_selectors_.clear();
+  generic_hidden_selectors_.clear();
+  pending_first_party_checks_.clear();
+  generic_style_sheet_key_.Reset();
+}
+
+void CosmeticFiltersAgent::OnGetUrlCosmeticResources(
+    mojom::CosmeticResourcesPtr resources) {
+  if (!resources)
+    return;
+
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (!resources->injected_script.empty()) {
+    frame->ExecuteScript(blink::WebScriptSource(
+        blink::WebString::FromUTF8(resources->injected_script)));
+  }
+
+  if (!render_frame()->IsMainFrame())
+    return;
+
+  resources_received_ = true;
+  hide_first_party_content_ = resources->hide_first_party_content;
+  generichide_ = resources->generichide;
+  skip_generic_selectors_ = IsVettedSearchEngine(GURL(GetDocument().Url()));
+  exceptions_ = std::move(resources->exceptions);
+
+  ForceHideSelectors(resources->force_hide_selectors);
+  if (hide_first_party_content_)
+    ForceHideSelectors(resources->hide_selectors);
+  else
+    HideSelectors(resources->hide_selectors);
+
+  std::string style_css;
+  for (const auto& style_selector : resources->style_selectors) {
+    style_css += style_selector.first + "{" +
+                 base::JoinString(style_selector.second, ";") + ";}\n";
+  }
+  if (!style_css.empty()) {
+    GetDocument().InsertStyleSheet(blink::WebString::FromUTF8(style_css),
+                                   nullptr, blink::WebDocument::kUserOrigin);
+  }
+
+  QueryNewClassIdSelectors();
+}
+
+void CosmeticFiltersAgent::QueryNewClassIdSelectors() {
+  if (!resources_received_ || !document_loaded_ || generichide_)
+    return;
+
+  std::vector<std::string> classes;
+  std::vector<std::string> ids;
+  const blink::WebElement root = GetDocument().DocumentElement();
+  for (blink::WebNode node = root; !node.IsNull(); node = NextNode(node, root)) {
+    if (!node.IsElementNode())
+      continue;
+    const blink::WebElement element = node.To<blink::WebElement>();
+
+    const std::string id = element.GetAttribute("id").Utf8();
+    if (!id.empty() && queried_ids_.insert(id).second)
+      ids.push_back(id);
+
+    const std::string class_attribute = element.GetAttribute("class").Utf8();
+    for (auto& class_name : base::SplitString(
+             class_attribute, base::kWhitespaceASCII, base::TRIM_WHITESPACE,
+             base::SPLIT_WANT_NONEMPTY)) {
+      if (queried_classes_.insert(class_name).second)
+        classes.push_back(std::move(class_name));
+    }
+  }
+
+  if (classes.empty() && ids.empty())
+    return;
+
+  GetCosmeticFiltersResources()->GetHiddenClassIdSelectors(
+      classes, ids, exceptions_,
+      base::BindOnce(&CosmeticFiltersAgent::OnGetHiddenClassIdSelectors,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void CosmeticFiltersAgent::OnGetHiddenClassIdSelectors(
+    const std::vector<std::string>& hide_selectors,
+    const std::vector<std::string>& force_hide_selectors) {
+  ForceHideSelectors(force_hide_selectors);
+  if (hide_first_party_content_)
+    ForceHideSelectors(hide_selectors);
+  else
+    HideSelectors(hide_selectors);
+  CheckFirstPartySelectors();
+}
+
+void CosmeticFiltersAgent::ForceHideSelectors(
+    const std::vector<std::string>& selectors) {
+  std::vector<std::string> new_selectors;
+  for (const auto& selector : selectors) {
+    if (known_selectors_.insert(selector).second)
+      new_selectors.push_back(selector);
+  }
+  if (new_selectors.empty())
+    return;
+
+  GetDocument().InsertStyleSheet(
+      blink::WebString::FromUTF8(HideRules(new_selectors)), nullptr,
+      blink::WebDocument::kUserOrigin);
+}
+
+void CosmeticFiltersAgent::HideSelectors(
+    const std::vector<std::string>& selectors) {
+  if (skip_generic_selectors_)
+    return;
+
+  bool changed = false;
+  for (const auto& selector : selectors) {
+    if (!known_selectors_.insert(selector).second)
+      continue;
+    generic_hidden_selectors_.push_back(selector);
+    pending_first_party_checks_[selector] = 0;
+    changed = true;
+  }
+  if (changed)
+    RebuildGenericStyleSheet();
+}
+
+void CosmeticFiltersAgent::CheckFirstPartySelectors() {
+  if (!document_loaded_ || pending_first_party_checks_.empty())
+    return;
+
+  blink::WebDocument document = GetDocument();
+  std::unordered_set<std::string> first_party_selectors;
+  for (auto it = pending_first_party_checks_.begin();
+       it != pending_first_party_checks_.end();) {
+    const blink::WebVector<blink::WebElement> elements =
+        document.QuerySelectorAll(blink::WebString::FromUTF8(it->first));
+    bool is_first_party = false;
+    for (const auto& element : elements) {
+      if (IsSubtreeFirstParty(document, element)) {
+        is_first_party = true;
+        break;
+      }
+    }
+
+    if (is_first_party) {
+      first_party_selectors.insert(it->first);
+      it = pending_first_party_checks_.erase(it);
+    } else if (++it->second >= kMaxFirstPartyChecks) {
+      it = pending_first_party_checks_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  if (first_party_selectors.empty())
+    return;
+
+  base::EraseIf(generic_hidden_selectors_,
+                [&first_party_selectors](const std::string& selector) {
+                  return base::Contains(first_party_selectors, selector);
+                });
+  RebuildGenericStyleSheet();
+}
+
+void CosmeticFiltersAgent::RebuildGenericStyleSheet() {
+  blink::WebDocument document = GetDocument();
+  if (!generic_style_sheet_key_.IsNull())
+    document.RemoveInsertedStyleSheet(generic_style_sheet_key_);
+  generic_style_sheet_key_.Reset();
+  if (generic_hidden_selectors_.empty())
+    return;
+
+  generic_style_sheet_key_ = document.InsertStyleSheet(
+      blink::WebString::FromUTF8(HideRules(generic_hidden_selectors_)),
+      nullptr, blink::WebDocument::kUserOrigin);
+}
+
+blink::WebDocument CosmeticFiltersAgent::GetDocument() {
+  return render_frame()->GetWebFrame()->GetDocument();
+}
+
+}  // namespace brave_shields
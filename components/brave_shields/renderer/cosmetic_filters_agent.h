@@ -0,0 +1,89 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_RENDERER_COSMETIC_FILTERS_AGENT_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_RENDERER_COSMETIC_FILTERS_AGENT_H_
+
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "base/memory/weak_ptr.h"
+#include "brave/components/brave_shields/common/cosmetic_filters.mojom.h"
+#include "content/public/renderer/render_frame_observer.h"
+#include "mojo/public/cpp/bindings/associated_remote.h"
+#include "third_party/blink/public/web/web_document.h"
+
+namespace brave_shields {
+
+// Applies ad-block cosmetic filters to the documents of a frame without going
+// through the Brave extension: the filters are fetched over mojo and applied
+// as user stylesheets, and the class and id tokens of the document are
+// collected natively once it has been parsed.
+//
+// As with the extension, scriptlets run in every frame while hiding only
+// happens in the main frame. Elements added after load are left to the
+// extension content script, which keeps observing DOM mutations.
+class CosmeticFiltersAgent : public content::RenderFrameObserver {
+ public:
+  explicit CosmeticFiltersAgent(content::RenderFrame* render_frame);
+  ~CosmeticFiltersAgent() override;
+
+ private:
+  // content::RenderFrameObserver
+  void DidCreateDocumentElement() override;
+  void DidFinishDocumentLoad() override;
+  void DidFinishLoad() override;
+  void OnDestruct() override;
+
+  mojom::CosmeticFiltersResources* GetCosmeticFiltersResources();
+  void ResetDocumentState();
+
+  void OnGetUrlCosmeticResources(mojom::CosmeticResourcesPtr resources);
+  void QueryNewClassIdSelectors();
+  void OnGetHiddenClassIdSelectors(
+      const std::vector<std::string>& hide_selectors,
+      const std::vector<std::string>& force_hide_selectors);
+
+  // Selectors that are always hidden go to an append-only stylesheet.
+  void ForceHideSelectors(const std::vector<std::string>& selectors);
+  // Other selectors are dropped again once they are found to match first
+  // party content, so they live in a stylesheet that gets rebuilt.
+  void HideSelectors(const std::vector<std::string>& selectors);
+  void CheckFirstPartySelectors();
+  void RebuildGenericStyleSheet();
+
+  blink::WebDocument GetDocument();
+
+  mojo::AssociatedRemote<mojom::CosmeticFiltersResources>
+      cosmetic_filters_resources_;
+
+  bool resources_received_ = false;
+  bool document_loaded_ = false;
+  bool hide_first_party_content_ = false;
+  bool generichide_ = false;
+  // Set on vetted search engines, where only forced selectors apply.
+  bool skip_generic_selectors_ = false;
+  std::vector<std::string> exceptions_;
+
+  std::unordered_set<std::string> queried_classes_;
+  std::unordered_set<std::string> queried_ids_;
+
+  std::unordered_set<std::string> known_selectors_;
+  std::vector<std::string> generic_hidden_selectors_;
+  // Generic selectors still to be checked for first party content, with the
+  // number of checks they went through.
+  std::map<std::string, int> pending_first_party_checks_;
+  blink::WebStyleSheetKey generic_style_sheet_key_;
+
+  base::WeakPtrFactory<CosmeticFiltersAgent> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(CosmeticFiltersAgent);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_RENDERER_COSMETIC_FILTERS_AGENT_H_
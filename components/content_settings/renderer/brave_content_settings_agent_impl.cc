@@ -99,6 +99,8 @@ void BraveContentSettingsAgentImpl::DidCommitProvisionalLoad(
     ui::PageTransition transition) {
   temporarily_allowed_scripts_ =
       std::move(preloaded_temporarily_allowed_scripts_);
+  // Content setting rules for the new document are sent before it commits.
+  farbling_level_.reset();
   ContentSettingsAgentImpl::DidCommitProvisionalLoad(transition);
 }
 
@@ -183,16 +185,20 @@ bool BraveContentSettingsAgentImpl::AllowFingerprinting(
     bool enabled_per_settings) {
   if (!enabled_per_settings)
     return false;
-  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
-  const GURL secondary_url(url::Origin(frame->GetSecurityOrigin()).GetURL());
-  if (IsBraveShieldsDown(frame, secondary_url)) {
-    return true;
-  }
-
+  // The farbling level is OFF when shields are down.
   return GetBraveFarblingLevel() != BraveFarblingLevel::MAXIMUM;
 }
 
 BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
+  // Nothing to cache until the rules are available.
+  if (!content_setting_rules_)
+    return ComputeBraveFarblingLevel();
+  if (!farbling_level_)
+    farbling_level_ = ComputeBraveFarblingLevel();
+  return *farbling_level_;
+}
+
+BraveFarblingLevel BraveContentSettingsAgentImpl::ComputeBraveFarblingLevel() {
   blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
 
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+#include "base/optional.h"
 #include "base/strings/string16.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "components/content_settings/core/common/content_settings.h"
@@ -62,6 +63,8 @@ class BraveContentSettingsAgentImpl : public ContentSettingsAgentImpl {
 
   bool IsScriptTemporilyAllowed(const GURL& script_url);
 
+  BraveFarblingLevel ComputeBraveFarblingLevel();
+
   // Origins of scripts which are temporary allowed for this frame in the
   // current load
   base::flat_set<std::string> temporarily_allowed_scripts_;
@@ -72,6 +75,10 @@ class BraveContentSettingsAgentImpl : public ContentSettingsAgentImpl {
   // temporary allowed script origins we preloaded for the next load
   base::flat_set<std::string> preloaded_temporarily_allowed_scripts_;
 
+  // Farbling level of the current document. It is queried from many Blink
+  // hooks, so it is computed once and reset when a new document commits.
+  base::Optional<BraveFarblingLevel> farbling_level_;
+
   DISALLOW_COPY_AND_ASSIGN(BraveContentSettingsAgentImpl);
 };
 
@@ -237,10 +237,10 @@ interface BlockDetails {
   subresource: string
 }
 
-interface BlockDetails {
+interface BlockedBatchDetails {
   blockType: BlockTypes
   tabId: number
-  subresource: string
+  subresources: string[]
 }
 declare namespace chrome.tabs {
   const setAsync: any
@@ -253,8 +253,8 @@ declare namespace chrome.windows {
 
 declare namespace chrome.braveShields {
   const onBlocked: {
-    addListener: (callback: (detail: BlockDetails) => void) => void
-    emit: (detail: BlockDetails) => void
+    addListener: (callback: (detail: BlockedBatchDetails) => void) => void
+    emit: (detail: BlockedBatchDetails) => void
   }
 
   const allowScriptsOnce: any
@@ -283,6 +283,7 @@ declare namespace chrome.braveShields {
     injected_script: string
     force_hide_selectors: string[]
     generichide: boolean
+    observe_mutations_only: boolean
   }
   const urlCosmeticResources: (url: string, callback: (resources: UrlSpecificResources) => void) => void
   const hiddenClassIdSelectors: (classes: string[], ids: string[], exceptions: string[], callback: (selectors: string[], forceHideSelectors: string[]) => void) => void
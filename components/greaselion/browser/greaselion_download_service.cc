@@ -225,6 +225,7 @@ GreaselionDownloadService::~GreaselionDownloadService() {}
 void GreaselionDownloadService::OnDATFileDataReady(std::string contents) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   rules_.clear();
+  rules_generation_++;
   if (contents.empty()) {
     LOG(ERROR) << "Could not obtain Greaselion configuration";
     return;
@@ -73,6 +73,13 @@ class GreaselionRule {
     return messages_;
   }
   bool has_unknown_preconditions() const { return has_unknown_preconditions_; }
+  // Digest of everything that ends up in the converted extension (manifest
+  // inputs, script and message file contents). Empty until the Greaselion
+  // service has hashed the rule on its file task runner.
+  const std::string& content_hash() const { return content_hash_; }
+  void set_content_hash(const std::string& content_hash) {
+    content_hash_ = content_hash;
+  }
 
  private:
   scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
@@ -88,6 +95,7 @@ class GreaselionRule {
   base::FilePath messages_;
   GreaselionPreconditions preconditions_;
   bool has_unknown_preconditions_ = false;
+  std::string content_hash_;
   base::WeakPtrFactory<GreaselionRule> weak_factory_;
   DISALLOW_COPY_AND_ASSIGN(GreaselionRule);
 };
@@ -102,6 +110,9 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
   ~GreaselionDownloadService() override;
 
   std::vector<std::unique_ptr<GreaselionRule>>* rules();
+  // Bumped every time |rules()| is reloaded, so that callers can tell results
+  // computed for an older set of rules apart.
+  int rules_generation() const { return rules_generation_; }
   scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
 
   // implementation of LocalDataFilesObserver
@@ -129,6 +140,7 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
 
   base::ObserverList<Observer> observers_;
   std::vector<std::unique_ptr<GreaselionRule>> rules_;
+  int rules_generation_ = 0;
   base::FilePath resource_dir_;
   bool is_dev_mode_ = false;
   std::unique_ptr<base::FilePathWatcher> dev_mode_path_watcher_;
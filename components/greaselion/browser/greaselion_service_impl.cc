@@ -6,7 +6,9 @@
 #include "brave/components/greaselion/browser/greaselion_service_impl.h"
 
 #include <stddef.h>
+#include <algorithm>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -16,12 +18,14 @@
 #include "base/bind_helpers.h"
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/json/json_file_value_serializer.h"
 #include "base/one_shot_event.h"
 #include "base/sequenced_task_runner.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
@@ -48,27 +52,139 @@ using extensions::Manifest;
 
 namespace {
 
-// Wraps a Greaselion rule in a component. The component is stored as an
-// unpacked extension in the system temp dir. Returns a valid extension that the
-// caller should take ownership of, or nullptr.
+constexpr base::FilePath::CharType kGreaselionDirname[] =
+    FILE_PATH_LITERAL("Greaselion");
+
+// Converted Greaselion extensions live next to (not inside) the extensions
+// install directory, because the extension garbage collector deletes anything
+// in there that isn't a valid extension id, including the Temp dir.
+base::FilePath GetConvertedExtensionsDir(const base::FilePath& extensions_dir) {
+  return extensions_dir.DirName().Append(kGreaselionDirname);
+}
+
+// Greaselion scripts are not signed, but the public key for an extension
+// doubles as its unique identity, and we need one of those, so we add the
+// rule name to a known Brave domain and hash the result to create a
+// public key.
+std::string GetPublicKeyForRule(const std::string& rule_name) {
+  char raw[crypto::kSHA256Length] = {0};
+  std::string key;
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  if (!command_line.HasSwitch(brave_component_updater::kUseGoUpdateDev) &&
+      !base::FeatureList::IsEnabled(
+          brave_component_updater::kUseDevUpdaterUrl)) {
+    crypto::SHA256HashString(UPDATER_DEV_ENDPOINT + rule_name,
+                             raw,
+                             crypto::kSHA256Length);
+  } else {
+    crypto::SHA256HashString(UPDATER_PROD_ENDPOINT + rule_name,
+                             raw,
+                             crypto::kSHA256Length);
+  }
+  base::Base64Encode(base::StringPiece(raw, crypto::kSHA256Length), &key);
+  return key;
+}
+
+void AppendHashInput(const std::string& data, std::string* input) {
+  // Length-prefix every field so that adjacent fields can't run together.
+  input->append(base::NumberToString(data.size()));
+  input->push_back(':');
+  input->append(data);
+}
+
+// Computes a digest of everything that ends up in the extension converted
+// from |rule|. Returns an empty string if any of the rule's files can't be
+// read.
 //
 // NOTE: This function does file IO and should not be called on the UI thread.
-// NOTE: The caller takes ownership of the directory at extension->path() on the
-// returned object.
-scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
-    greaselion::GreaselionRule* rule,
+std::string ComputeRuleContentHash(const greaselion::GreaselionRuleData& rule) {
+  std::string input;
+  AppendHashInput(rule.name, &input);
+  AppendHashInput(GetPublicKeyForRule(rule.name), &input);
+  AppendHashInput(rule.run_at, &input);
+  for (const auto& url_pattern : rule.url_patterns)
+    AppendHashInput(url_pattern, &input);
+
+  for (const auto& script : rule.scripts) {
+    std::string contents;
+    if (!base::ReadFileToString(script, &contents))
+      return std::string();
+    AppendHashInput(script.BaseName().AsUTF8Unsafe(), &input);
+    AppendHashInput(contents, &input);
+  }
+
+  if (!rule.messages.empty()) {
+    std::vector<base::FilePath> message_files;
+    base::FileEnumerator enumerator(rule.messages, true,
+                                    base::FileEnumerator::FILES);
+    for (base::FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      message_files.push_back(path);
+    }
+    std::sort(message_files.begin(), message_files.end());
+    for (const auto& path : message_files) {
+      base::FilePath relative_path;
+      std::string contents;
+      if (!rule.messages.AppendRelativePath(path, &relative_path) ||
+          !base::ReadFileToString(path, &contents)) {
+        return std::string();
+      }
+      AppendHashInput(relative_path.AsUTF8Unsafe(), &input);
+      AppendHashInput(contents, &input);
+    }
+  }
+
+  const std::string digest = crypto::SHA256HashString(input);
+  return base::ToLowerASCII(base::HexEncode(digest.data(), digest.size()));
+}
+
+// Hashes every rule. Returns the hashes in the order of |rules|.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+std::vector<std::string> ComputeRuleContentHashesOnTaskRunner(
+    std::vector<greaselion::GreaselionRuleData> rules) {
+  std::vector<std::string> hashes;
+  for (const auto& rule : rules)
+    hashes.push_back(ComputeRuleContentHash(rule));
+  return hashes;
+}
+
+// Deletes converted extension directories whose content hash isn't in
+// |hashes_to_keep|. Must only run once the extensions loaded from those
+// directories have been unloaded.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+void DeleteStaleConvertedExtensionsOnTaskRunner(
+    std::set<std::string> hashes_to_keep,
     const base::FilePath& extensions_dir) {
+  base::FileEnumerator enumerator(GetConvertedExtensionsDir(extensions_dir),
+                                  false, base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    if (!hashes_to_keep.count(path.BaseName().AsUTF8Unsafe()))
+      base::DeletePathRecursively(path);
+  }
+}
+
+// Writes the unpacked extension for |rule| to |extension_dir|, which must not
+// exist yet. Returns false on failure.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+bool WriteGreaselionRuleExtension(const greaselion::GreaselionRuleData& rule,
+                                  const base::FilePath& extensions_dir,
+                                  const base::FilePath& extension_dir) {
   base::FilePath install_temp_dir =
       extensions::file_util::GetInstallTempDir(extensions_dir);
   if (install_temp_dir.empty()) {
     LOG(ERROR) << "Could not get path to profile temp directory";
-    return nullptr;
+    return false;
   }
 
   base::ScopedTempDir temp_dir;
   if (!temp_dir.CreateUniqueTempDirUnderPath(install_temp_dir)) {
     LOG(ERROR) << "Could not create Greaselion temp directory";
-    return nullptr;
+    return false;
   }
 
   // Create the manifest
@@ -78,40 +194,19 @@ scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
   // see kModernManifestVersion in src/extensions/common/extension.cc
   root->SetIntPath(extensions::manifest_keys::kManifestVersion, 2);
 
-  // Create the public key.
-  // Greaselion scripts are not signed, but the public key for an extension
-  // doubles as its unique identity, and we need one of those, so we add the
-  // rule name to a known Brave domain and hash the result to create a
-  // public key.
-  char raw[crypto::kSHA256Length] = {0};
-  std::string key;
-  std::string script_name = rule->name();
-  const base::CommandLine& command_line =
-      *base::CommandLine::ForCurrentProcess();
-  if (!command_line.HasSwitch(brave_component_updater::kUseGoUpdateDev) &&
-      !base::FeatureList::IsEnabled(
-          brave_component_updater::kUseDevUpdaterUrl)) {
-    crypto::SHA256HashString(UPDATER_DEV_ENDPOINT + script_name,
-                             raw,
-                             crypto::kSHA256Length);
-  } else {
-    crypto::SHA256HashString(UPDATER_PROD_ENDPOINT + script_name,
-                             raw,
-                             crypto::kSHA256Length);
-  }
-  base::Base64Encode(base::StringPiece(raw, crypto::kSHA256Length), &key);
-
+  std::string script_name = rule.name;
   root->SetStringPath(extensions::manifest_keys::kName, script_name);
   root->SetStringPath(extensions::manifest_keys::kVersion, "1.0");
   root->SetStringPath(extensions::manifest_keys::kDescription, "");
-  root->SetStringPath(extensions::manifest_keys::kPublicKey, key);
+  root->SetStringPath(extensions::manifest_keys::kPublicKey,
+                      GetPublicKeyForRule(script_name));
 
   auto js_files = std::make_unique<base::ListValue>();
-  for (auto script : rule->scripts())
+  for (auto script : rule.scripts)
     js_files->AppendString(script.BaseName().value());
 
   auto matches = std::make_unique<base::ListValue>();
-  for (auto url_pattern : rule->url_patterns())
+  for (auto url_pattern : rule.url_patterns)
     matches->AppendString(url_pattern);
 
   auto content_script = std::make_unique<base::DictionaryValue>();
@@ -119,11 +214,11 @@ scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
   content_script->Set(extensions::manifest_keys::kJs, std::move(js_files));
   // All Greaselion scripts default to document end.
   content_script->SetStringPath(extensions::manifest_keys::kRunAt,
-      rule->run_at() == extensions::manifest_values::kRunAtDocumentStart
+      rule.run_at == extensions::manifest_values::kRunAtDocumentStart
         ? extensions::manifest_values::kRunAtDocumentStart
         : extensions::manifest_values::kRunAtDocumentEnd);
 
-  if (!rule->messages().empty()) {
+  if (!rule.messages.empty()) {
     root->SetStringPath(extensions::manifest_keys::kDefaultLocale, "en_US");
   }
 
@@ -143,45 +238,90 @@ scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
   // files to disk.
   if (!serializer.Serialize(*root)) {
     LOG(ERROR) << "Could not write Greaselion manifest";
-    return nullptr;
+    return false;
   }
 
   // Copy the messages directory to our extension directory.
-  if (!rule->messages().empty()) {
+  if (!rule.messages.empty()) {
     if (!base::CopyDirectory(
-            rule->messages(),
+            rule.messages,
             temp_dir.GetPath().AppendASCII("_locales"), true)) {
       LOG(ERROR) << "Could not copy Greaselion messages directory at path: "
-                 << rule->messages().LossyDisplayName();
-      return nullptr;
+                 << rule.messages.LossyDisplayName();
+      return false;
     }
   }
 
   // Copy the script files to our extension directory.
-  for (auto script : rule->scripts()) {
+  for (auto script : rule.scripts) {
     if (!base::CopyFile(script, temp_dir.GetPath().Append(script.BaseName()))) {
       LOG(ERROR) << "Could not copy Greaselion script at path: "
           << script.LossyDisplayName();
-      return nullptr;
+      return false;
     }
   }
 
+  // Only publish the directory once it is complete, so that a later session
+  // never picks up a partially written extension.
+  if (!base::CreateDirectory(extension_dir.DirName()) ||
+      !base::Move(temp_dir.GetPath(), extension_dir)) {
+    LOG(ERROR) << "Could not move Greaselion extension to path: "
+               << extension_dir.LossyDisplayName();
+    return false;
+  }
+  temp_dir.Take();  // The directory now lives at |extension_dir|.
+  return true;
+}
+
+// Wraps a Greaselion rule in a component. The component is stored as an
+// unpacked extension in a directory named after |content_hash|, which is
+// reused as-is if a previous conversion already wrote it. Returns a valid
+// extension that the caller should take ownership of, or nullptr.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
+    const greaselion::GreaselionRuleData& rule,
+    const std::string& content_hash,
+    const base::FilePath& extensions_dir) {
+  base::FilePath extension_dir =
+      GetConvertedExtensionsDir(extensions_dir).AppendASCII(content_hash);
+  if (!base::PathExists(extension_dir.Append(extensions::kManifestFilename))) {
+    base::DeletePathRecursively(extension_dir);
+    if (!WriteGreaselionRuleExtension(rule, extensions_dir, extension_dir))
+      return nullptr;
+  }
+
   std::string error;
   scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
-      temp_dir.GetPath(), Manifest::COMPONENT, Extension::NO_FLAGS, &error);
+      extension_dir, Manifest::COMPONENT, Extension::NO_FLAGS, &error);
   if (!extension.get()) {
     LOG(ERROR) << "Could not load Greaselion extension";
     LOG(ERROR) << error;
+    base::DeletePathRecursively(extension_dir);
     return nullptr;
   }
 
-  temp_dir.Take();  // The caller takes ownership of the directory.
   return extension;
 }
+
 }  // namespace
 
 namespace greaselion {
 
+GreaselionRuleData::GreaselionRuleData() = default;
+
+GreaselionRuleData::GreaselionRuleData(const GreaselionRule& rule)
+    : name(rule.name()),
+      url_patterns(rule.url_patterns()),
+      scripts(rule.scripts()),
+      run_at(rule.run_at()),
+      messages(rule.messages()) {}
+
+GreaselionRuleData::GreaselionRuleData(const GreaselionRuleData& other) =
+    default;
+
+GreaselionRuleData::~GreaselionRuleData() = default;
+
 GreaselionServiceImpl::GreaselionServiceImpl(
     GreaselionDownloadService* download_service,
     const base::FilePath& install_directory,
@@ -213,13 +353,15 @@ GreaselionServiceImpl::~GreaselionServiceImpl() {
 }
 
 bool GreaselionServiceImpl::IsGreaselionExtension(const std::string& id) {
-  return std::find(greaselion_extensions_.begin(), greaselion_extensions_.end(),
-                   id) != greaselion_extensions_.end();
+  return greaselion_extensions_.find(id) != greaselion_extensions_.end();
 }
 
 std::vector<extensions::ExtensionId>
 GreaselionServiceImpl::GetExtensionIdsForTesting() {
-  return greaselion_extensions_;
+  std::vector<extensions::ExtensionId> ids;
+  for (const auto& it : greaselion_extensions_)
+    ids.push_back(it.first);
+  return ids;
 }
 
 void GreaselionServiceImpl::UpdateInstalledExtensions() {
@@ -228,60 +370,161 @@ void GreaselionServiceImpl::UpdateInstalledExtensions() {
     return;
   }
   update_in_progress_ = true;
-  if (greaselion_extensions_.empty()) {
-    // No Greaselion extensions are currently installed, so we can move on to
-    // the install phase immediately.
+
+  std::vector<std::unique_ptr<GreaselionRule>>* rules =
+      download_service_->rules();
+  std::vector<GreaselionRuleData> all_rules;
+  bool needs_hashing = false;
+  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
+    all_rules.emplace_back(*rule);
+    if (rule->content_hash().empty())
+      needs_hashing = true;
+  }
+  if (!needs_hashing) {
+    // Feature state changes end up here; the rules themselves haven't changed
+    // so we can diff against what's installed right away.
+    SyncInstalledExtensions();
+    return;
+  }
+
+  // Hashing reads the rule files, so it must run on the extension file task
+  // runner, which was passed in in the constructor.
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&ComputeRuleContentHashesOnTaskRunner,
+                     std::move(all_rules)),
+      base::BindOnce(&GreaselionServiceImpl::PostComputeContentHashes,
+                     weak_factory_.GetWeakPtr(),
+                     download_service_->rules_generation()));
+}
+
+void GreaselionServiceImpl::PostComputeContentHashes(
+    int rules_generation,
+    std::vector<std::string> hashes) {
+  DCHECK(update_in_progress_);
+  std::vector<std::unique_ptr<GreaselionRule>>* rules =
+      download_service_->rules();
+  if (rules_generation != download_service_->rules_generation()) {
+    // The rules were reloaded while we were hashing them. Start over.
+    update_pending_ = true;
+    pending_installs_ = 0;
+    MaybeNotifyObservers();
+    return;
+  }
+  for (size_t i = 0; i < hashes.size(); ++i)
+    (*rules)[i]->set_content_hash(hashes[i]);
+
+  // Drop converted extensions that no longer belong to any rule.
+  for (auto it = converted_extensions_.begin();
+       it != converted_extensions_.end();) {
+    if (std::find(hashes.begin(), hashes.end(), it->first) == hashes.end())
+      it = converted_extensions_.erase(it);
+    else
+      ++it;
+  }
+
+  SyncInstalledExtensions();
+}
+
+std::vector<GreaselionRule*> GreaselionServiceImpl::GetMatchingRules() {
+  std::vector<GreaselionRule*> matching_rules;
+  for (const std::unique_ptr<GreaselionRule>& rule :
+       *download_service_->rules()) {
+    if (rule->Matches(state_, browser_version_) &&
+        rule->has_unknown_preconditions() == false) {
+      matching_rules.push_back(rule.get());
+    }
+  }
+  return matching_rules;
+}
+
+void GreaselionServiceImpl::SyncInstalledExtensions() {
+  DCHECK(update_in_progress_);
+  all_rules_installed_successfully_ = true;
+  pending_installs_ = 0;
+  rules_to_install_.clear();
+  for (GreaselionRule* rule : GetMatchingRules()) {
+    if (rule->content_hash().empty()) {
+      LOG(ERROR) << "Could not read Greaselion rule " << rule->name();
+      all_rules_installed_successfully_ = false;
+      continue;
+    }
+    rules_to_install_.emplace(rule->content_hash(), GreaselionRuleData(*rule));
+  }
+
+  // Anything installed from a rule that still matches with the same content
+  // stays as it is; everything else gets unloaded.
+  pending_unloads_.clear();
+  for (const auto& it : greaselion_extensions_) {
+    if (!rules_to_install_.erase(it.second))
+      pending_unloads_.insert(it.first);
+  }
+  if (pending_unloads_.empty()) {
     CreateAndInstallExtensions();
     return;
   }
 
-  // Make a copy of greaselion_extensions_ to iterate while the original vector
-  // changes.
-  std::vector<extensions::ExtensionId> extensions = greaselion_extensions_;
+  // Make a copy of pending_unloads_ to iterate while the original set changes.
+  std::set<extensions::ExtensionId> extensions = pending_unloads_;
   for (auto id : extensions) {
-    // We need to unload all the Greaselion extensions that are already
-    // installed. OnExtensionUnloaded will be called on each extension, where we
-    // will update the greaselion_extensions_ set. Once it's empty, that
-    // callback will call CreateAndInstallExtensions().
+    // OnExtensionUnloaded will be called on each extension, where we will
+    // update the pending_unloads_ set. Once it's empty, that callback will
+    // call CreateAndInstallExtensions().
     extension_service_->UnloadExtension(
         id, extensions::UnloadedExtensionReason::UPDATE);
   }
 }
 
 void GreaselionServiceImpl::CreateAndInstallExtensions() {
-  DCHECK(greaselion_extensions_.empty());
+  DCHECK(pending_unloads_.empty());
   DCHECK(update_in_progress_);
-  all_rules_installed_successfully_ = true;
-  pending_installs_ = 0;
-  std::vector<std::unique_ptr<GreaselionRule>>* rules =
-      download_service_->rules();
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      pending_installs_ += 1;
-    }
+  std::map<std::string, GreaselionRuleData> rules_to_install;
+  rules_to_install.swap(rules_to_install_);
+
+  // Every stale extension has been unloaded by now, so the directories that
+  // don't belong to a known rule or a remaining extension can go. This is
+  // sequenced before the conversions below on the same task runner.
+  std::set<std::string> hashes_to_keep;
+  for (const std::unique_ptr<GreaselionRule>& rule :
+       *download_service_->rules()) {
+    if (!rule->content_hash().empty())
+      hashes_to_keep.insert(rule->content_hash());
   }
+  for (const auto& it : greaselion_extensions_)
+    hashes_to_keep.insert(it.second);
+  for (const auto& it : converted_extensions_)
+    hashes_to_keep.insert(it.first);
+  for (const auto& it : rules_to_install)
+    hashes_to_keep.insert(it.first);
+  task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&DeleteStaleConvertedExtensionsOnTaskRunner,
+                                std::move(hashes_to_keep), install_directory_));
+
+  pending_installs_ = rules_to_install.size();
   if (!pending_installs_) {
-    // no rules match, nothing else to do
+    // nothing changed, nothing else to do
     MaybeNotifyObservers();
     return;
   }
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      // Convert script file to component extension. This must run on extension
-      // file task runner, which was passed in in the constructor.
-      base::PostTaskAndReplyWithResult(
-          task_runner_.get(), FROM_HERE,
-          base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule.get(), install_directory_),
-          base::BindOnce(&GreaselionServiceImpl::PostConvert,
-                         weak_factory_.GetWeakPtr()));
+  for (const auto& it : rules_to_install) {
+    auto converted = converted_extensions_.find(it.first);
+    if (converted != converted_extensions_.end()) {
+      PostConvert(it.first, converted->second);
+      continue;
     }
+    // Convert script file to component extension. This must run on extension
+    // file task runner, which was passed in in the constructor.
+    base::PostTaskAndReplyWithResult(
+        task_runner_.get(), FROM_HERE,
+        base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
+                       it.second, it.first, install_directory_),
+        base::BindOnce(&GreaselionServiceImpl::PostConvert,
+                       weak_factory_.GetWeakPtr(), it.first));
   }
 }
 
 void GreaselionServiceImpl::PostConvert(
+    const std::string& content_hash,
     scoped_refptr<extensions::Extension> extension) {
   if (!extension.get()) {
     all_rules_installed_successfully_ = false;
@@ -289,7 +532,8 @@ void GreaselionServiceImpl::PostConvert(
     MaybeNotifyObservers();
     LOG(ERROR) << "Could not load Greaselion script";
   } else {
-    greaselion_extensions_.push_back(extension->id());
+    converted_extensions_[content_hash] = extension;
+    greaselion_extensions_[extension->id()] = content_hash;
     extension_system_->ready().Post(
         FROM_HERE,
         base::BindOnce(&GreaselionServiceImpl::Install,
@@ -305,9 +549,7 @@ void GreaselionServiceImpl::Install(
 void GreaselionServiceImpl::OnExtensionReady(
     content::BrowserContext* browser_context,
     const extensions::Extension* extension) {
-  auto index = std::find(greaselion_extensions_.begin(),
-                         greaselion_extensions_.end(), extension->id());
-  if (index == greaselion_extensions_.end()) {
+  if (!IsGreaselionExtension(extension->id())) {
     // not one of ours
     return;
   }
@@ -320,14 +562,12 @@ void GreaselionServiceImpl::OnExtensionUnloaded(
     content::BrowserContext* browser_context,
     const extensions::Extension* extension,
     extensions::UnloadedExtensionReason reason) {
-  auto index = std::find(greaselion_extensions_.begin(),
-                         greaselion_extensions_.end(), extension->id());
-  if (index == greaselion_extensions_.end()) {
+  if (!greaselion_extensions_.erase(extension->id())) {
     // not one of ours
     return;
   }
-  greaselion_extensions_.erase(index);
-  if (update_in_progress_ && greaselion_extensions_.empty()) {
+  if (pending_unloads_.erase(extension->id()) && update_in_progress_ &&
+      pending_unloads_.empty()) {
     // It's time!
     CreateAndInstallExtensions();
   }
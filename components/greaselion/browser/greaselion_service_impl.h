@@ -7,11 +7,13 @@
 #define BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_SERVICE_IMPL_H_
 
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "base/files/file_path.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/version.h"
 #include "brave/components/greaselion/browser/greaselion_service.h"
@@ -32,6 +34,23 @@ class ExtensionSystem;
 namespace greaselion {
 
 class GreaselionDownloadService;
+class GreaselionRule;
+
+// Copy of everything that goes into the extension converted from a
+// GreaselionRule. The download service owns the rules and may replace them at
+// any time, so file task runner work only ever sees one of these.
+struct GreaselionRuleData {
+  GreaselionRuleData();
+  explicit GreaselionRuleData(const GreaselionRule& rule);
+  GreaselionRuleData(const GreaselionRuleData& other);
+  ~GreaselionRuleData();
+
+  std::string name;
+  std::vector<std::string> url_patterns;
+  std::vector<base::FilePath> scripts;
+  std::string run_at;
+  base::FilePath messages;
+};
 
 class GreaselionServiceImpl : public GreaselionService {
  public:
@@ -61,8 +80,13 @@ class GreaselionServiceImpl : public GreaselionService {
 
  private:
   void SetBrowserVersionForTesting(const base::Version& version) override;
+  std::vector<GreaselionRule*> GetMatchingRules();
+  void PostComputeContentHashes(int rules_generation,
+                                std::vector<std::string> hashes);
+  void SyncInstalledExtensions();
   void CreateAndInstallExtensions();
-  void PostConvert(scoped_refptr<extensions::Extension> extension);
+  void PostConvert(const std::string& content_hash,
+                   scoped_refptr<extensions::Extension> extension);
   void Install(scoped_refptr<extensions::Extension> extension);
   void MaybeNotifyObservers();
 
@@ -78,7 +102,18 @@ class GreaselionServiceImpl : public GreaselionService {
   int pending_installs_;
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   base::ObserverList<Observer> observers_;
-  std::vector<extensions::ExtensionId> greaselion_extensions_;
+  // Installed (or installing) Greaselion extensions, mapped to the content
+  // hash of the rule they were converted from.
+  std::map<extensions::ExtensionId, std::string> greaselion_extensions_;
+  // Extensions that were already converted during this session, keyed by
+  // rule content hash, so that feature state flips can reinstall them without
+  // touching the disk.
+  std::map<std::string, scoped_refptr<extensions::Extension>>
+      converted_extensions_;
+  // Rules that should be installed once the current update has unloaded
+  // every stale extension, keyed by content hash.
+  std::map<std::string, GreaselionRuleData> rules_to_install_;
+  std::set<extensions::ExtensionId> pending_unloads_;
   base::Version browser_version_;
   base::WeakPtrFactory<GreaselionServiceImpl> weak_factory_;
 
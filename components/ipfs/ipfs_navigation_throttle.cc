@@ -106,6 +106,11 @@ IpfsNavigationThrottle::WillStartRequest() {
 
   // Check # of connected peers before using local node.
   if (is_local_mode && ipfs_service_->IsDaemonLaunched()) {
+    // Peers seen recently are good enough, no need to defer on the daemon.
+    std::vector<std::string> peers;
+    if (ipfs_service_->GetCachedConnectedPeers(&peers))
+      return content::NavigationThrottle::PROCEED;
+
     resume_pending_ = true;
     ipfs_service_->GetConnectedPeers(
         base::BindOnce(&IpfsNavigationThrottle::OnGetConnectedPeers,
@@ -15,6 +15,7 @@
 #include "base/strings/string_util.h"
 #include "base/task/post_task.h"
 #include "base/task_runner_util.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "brave/components/ipfs/features.h"
 #include "brave/components/ipfs/ipfs_constants.h"
 #include "brave/components/ipfs/ipfs_json_parser.h"
@@ -38,6 +39,14 @@
 
 namespace {
 
+// How long a list of connected peers is trusted before asking the daemon
+// again, and how often it is refreshed in the background while the daemon
+// is running.
+constexpr base::TimeDelta kConnectedPeersCacheTTL =
+    base::TimeDelta::FromSeconds(30);
+constexpr base::TimeDelta kConnectedPeersRefreshInterval =
+    base::TimeDelta::FromSeconds(20);
+
 net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
   return net::DefineNetworkTrafficAnnotation("ipfs_service", R"(
       semantics {
@@ -185,6 +194,10 @@ base::FilePath IpfsService::GetConfigFilePath() const {
 void IpfsService::OnIpfsLaunched(bool result, int64_t pid) {
   if (result) {
     ipfs_pid_ = pid;
+    connected_peers_refresh_timer_.Start(
+        FROM_HERE, kConnectedPeersRefreshInterval, this,
+        &IpfsService::OnConnectedPeersRefreshTimerFired);
+    RequestConnectedPeers();
   } else {
     VLOG(0) << "Failed to launch IPFS";
     Shutdown();
@@ -206,6 +219,8 @@ void IpfsService::Shutdown() {
 
   ipfs_service_.reset();
   ipfs_pid_ = -1;
+  connected_peers_refresh_timer_.Stop();
+  ResetConnectedPeers();
 }
 
 std::unique_ptr<network::SimpleURLLoader> IpfsService::CreateURLLoader(
@@ -238,18 +253,44 @@ void IpfsService::GetConnectedPeers(GetConnectedPeersCallback callback) {
     return;
   }
 
+  std::vector<std::string> peers;
+  if (GetCachedConnectedPeers(&peers)) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(std::move(callback), true, std::move(peers)));
+    return;
+  }
+
+  connected_peers_callbacks_.push_back(std::move(callback));
+  RequestConnectedPeers();
+}
+
+bool IpfsService::GetCachedConnectedPeers(
+    std::vector<std::string>* peers) const {
+  DCHECK(peers);
+  if (!IsDaemonLaunched() || connected_peers_.empty() ||
+      base::TimeTicks::Now() - connected_peers_time_ > kConnectedPeersCacheTTL)
+    return false;
+
+  *peers = connected_peers_;
+  return true;
+}
+
+void IpfsService::RequestConnectedPeers() {
+  if (connected_peers_request_pending_)
+    return;
+  connected_peers_request_pending_ = true;
+
   auto url_loader = CreateURLLoader(server_endpoint_.Resolve(kSwarmPeersPath));
   auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
 
   iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       url_loader_factory_.get(),
       base::BindOnce(&IpfsService::OnGetConnectedPeers, base::Unretained(this),
-                     std::move(iter), std::move(callback)));
+                     std::move(iter)));
 }
 
 void IpfsService::OnGetConnectedPeers(
     SimpleURLLoaderList::iterator iter,
-    GetConnectedPeersCallback callback,
     std::unique_ptr<std::string> response_body) {
   auto* url_loader = iter->get();
   int error_code = url_loader->NetError();
@@ -257,17 +298,44 @@ void IpfsService::OnGetConnectedPeers(
   if (url_loader->ResponseInfo() && url_loader->ResponseInfo()->headers)
     response_code = url_loader->ResponseInfo()->headers->response_code();
   url_loaders_.erase(iter);
+  connected_peers_request_pending_ = false;
 
+  std::vector<std::string> peers;
+  bool success = false;
   if (error_code != net::OK || response_code != net::HTTP_OK) {
     VLOG(1) << "Fail to get connected peers, error_code = " << error_code
             << " response_code = " << response_code;
-    std::move(callback).Run(false, std::vector<std::string>{});
+  } else {
+    success = IPFSJSONParser::GetPeersFromJSON(*response_body, &peers);
+  }
+
+  // An empty list is not cached: a freshly launched daemon usually has no
+  // peers yet, and callers should see them as soon as they connect.
+  if (success && !peers.empty()) {
+    connected_peers_ = peers;
+    connected_peers_time_ = base::TimeTicks::Now();
+  } else {
+    ResetConnectedPeers();
+  }
+
+  // Callbacks may call back into GetConnectedPeers, so run a local copy.
+  std::vector<GetConnectedPeersCallback> callbacks;
+  callbacks.swap(connected_peers_callbacks_);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(success, peers);
+}
+
+void IpfsService::OnConnectedPeersRefreshTimerFired() {
+  if (!IsDaemonLaunched()) {
+    connected_peers_refresh_timer_.Stop();
     return;
   }
+  RequestConnectedPeers();
+}
 
-  std::vector<std::string> peers;
-  bool success = IPFSJSONParser::GetPeersFromJSON(*response_body, &peers);
-  std::move(callback).Run(success, peers);
+void IpfsService::ResetConnectedPeers() {
+  connected_peers_.clear();
+  connected_peers_time_ = base::TimeTicks();
 }
 
 void IpfsService::GetAddressesConfig(GetAddressesConfigCallback callback) {
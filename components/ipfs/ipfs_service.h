@@ -14,6 +14,8 @@
 
 #include "base/memory/scoped_refptr.h"
 #include "base/observer_list.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "brave/components/ipfs/addresses_config.h"
 #include "brave/components/ipfs/brave_ipfs_client_updater.h"
 #include "brave/components/ipfs/ipfs_constants.h"
@@ -75,7 +77,12 @@ class IpfsService : public KeyedService,
   // KeyedService
   void Shutdown() override;
 
+  // Served from the cached peers when they are fresh enough; otherwise
+  // concurrent callers share a single request to the daemon.
   void GetConnectedPeers(GetConnectedPeersCallback callback);
+  // Returns true and fills |peers| if a recent list of connected peers is
+  // cached, letting callers skip the round trip to the daemon.
+  bool GetCachedConnectedPeers(std::vector<std::string>* peers) const;
   void GetAddressesConfig(GetAddressesConfigCallback callback);
   void LaunchDaemon(LaunchDaemonCallback callback);
   void ShutdownDaemon(ShutdownDaemonCallback callback);
@@ -106,9 +113,11 @@ class IpfsService : public KeyedService,
 
   std::unique_ptr<network::SimpleURLLoader> CreateURLLoader(const GURL& gurl);
 
+  void RequestConnectedPeers();
   void OnGetConnectedPeers(SimpleURLLoaderList::iterator iter,
-                           GetConnectedPeersCallback,
                            std::unique_ptr<std::string> response_body);
+  void OnConnectedPeersRefreshTimerFired();
+  void ResetConnectedPeers();
   void OnGetAddressesConfig(SimpleURLLoaderList::iterator iter,
                             GetAddressesConfigCallback callback,
                             std::unique_ptr<std::string> response_body);
@@ -127,6 +136,15 @@ class IpfsService : public KeyedService,
 
   LaunchDaemonCallback launch_daemon_callback_;
 
+  // Peers from the last successful swarm peers request that returned any,
+  // kept warm by |connected_peers_refresh_timer_| while the daemon runs.
+  std::vector<std::string> connected_peers_;
+  base::TimeTicks connected_peers_time_;
+  // Callbacks waiting on the in-flight swarm peers request, if any.
+  std::vector<GetConnectedPeersCallback> connected_peers_callbacks_;
+  bool connected_peers_request_pending_ = false;
+  base::RepeatingTimer connected_peers_refresh_timer_;
+
   bool is_ipfs_launched_for_test_ = false;
   bool skip_get_connected_peers_callback_for_test_ = false;
   GURL server_endpoint_;
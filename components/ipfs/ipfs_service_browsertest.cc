@@ -3,9 +3,12 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <atomic>
+
 #include "base/path_service.h"
 #include "base/run_loop.h"
 #include "base/strings/strcat.h"
+#include "base/test/bind_test_util.h"
 #include "base/test/scoped_feature_list.h"
 #include "brave/browser/ipfs/ipfs_service_factory.h"
 #include "brave/common/brave_paths.h"
@@ -67,6 +70,7 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
     if (request.GetURL().path_piece() != kSwarmPeersPath) {
       return nullptr;
     }
+    ++connected_peers_requests_;
 
     auto http_response =
         std::make_unique<net::test_server::BasicHttpResponse>();
@@ -169,6 +173,7 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
   }
 
   IpfsService* ipfs_service() { return ipfs_service_; }
+  int connected_peers_requests() const { return connected_peers_requests_; }
 
   void OnGetConnectedPeersSuccess(bool success,
                                   const std::vector<std::string>& peers) {
@@ -179,6 +184,16 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
     EXPECT_EQ(peers, GetExpectedPeers());
   }
 
+  void OnGetConnectedPeersCounted(int* remaining,
+                                  bool success,
+                                  const std::vector<std::string>& peers) {
+    EXPECT_TRUE(success);
+    EXPECT_EQ(peers, GetExpectedPeers());
+    if (--*remaining == 0 && wait_for_request_) {
+      wait_for_request_->Quit();
+    }
+  }
+
   void OnGetConnectedPeersFail(bool success,
                                const std::vector<std::string>& peers) {
     if (wait_for_request_) {
@@ -221,6 +236,8 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
  private:
   std::unique_ptr<base::RunLoop> wait_for_request_;
   std::unique_ptr<net::EmbeddedTestServer> test_server_;
+  // Incremented on the test server's thread.
+  std::atomic<int> connected_peers_requests_{0};
   IpfsService* ipfs_service_;
   base::test::ScopedFeatureList feature_list_;
 };
@@ -235,6 +252,37 @@ IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, GetConnectedPeers) {
   WaitForRequest();
 }
 
+IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, GetConnectedPeersCoalesced) {
+  ResetTestServer(
+      base::BindRepeating(&IpfsServiceBrowserTest::HandleGetConnectedPeers,
+                          base::Unretained(this)));
+  // Concurrent callers share one request to the daemon.
+  int remaining = 3;
+  for (int i = 0; i < 3; ++i) {
+    ipfs_service()->GetConnectedPeers(
+        base::BindOnce(&IpfsServiceBrowserTest::OnGetConnectedPeersCounted,
+                       base::Unretained(this), &remaining));
+  }
+  WaitForRequest();
+  EXPECT_EQ(remaining, 0);
+  EXPECT_EQ(connected_peers_requests(), 1);
+
+  std::vector<std::string> peers;
+  EXPECT_TRUE(ipfs_service()->GetCachedConnectedPeers(&peers));
+  EXPECT_EQ(peers, GetExpectedPeers());
+
+  // Later callers are served from the cache.
+  base::RunLoop run_loop;
+  ipfs_service()->GetConnectedPeers(base::BindLambdaForTesting(
+      [&](bool success, const std::vector<std::string>& peers) {
+        EXPECT_TRUE(success);
+        EXPECT_EQ(peers, GetExpectedPeers());
+        run_loop.Quit();
+      }));
+  run_loop.Run();
+  EXPECT_EQ(connected_peers_requests(), 1);
+}
+
 IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, GetConnectedPeersServerError) {
   ResetTestServer(
       base::BindRepeating(&IpfsServiceBrowserTest::HandleRequestServerError,
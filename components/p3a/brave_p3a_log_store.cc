@@ -22,6 +22,11 @@ constexpr char kLogValueKey[] = "value";
 constexpr char kLogSentKey[] = "sent";
 constexpr char kLogTimestampKey[] = "timestamp";
 
+// Histograms can change many times in a row (e.g. on startup), so value
+// updates are batched into a single pref write.
+constexpr base::TimeDelta kPersistValuesDelay =
+    base::TimeDelta::FromSeconds(10);
+
 void RecordP3A(uint64_t answers_count) {
   int answer = 0;
   if (1 <= answers_count && answers_count < 5) {
@@ -43,7 +48,10 @@ BraveP3ALogStore::BraveP3ALogStore(Delegate* delegate,
   DCHECK(local_state);
 }
 
-BraveP3ALogStore::~BraveP3ALogStore() = default;
+BraveP3ALogStore::~BraveP3ALogStore() {
+  // Don't lose value updates that are still waiting for the timer.
+  PersistPendingValues();
+}
 
 void BraveP3ALogStore::RegisterPrefs(PrefRegistrySimple* registry) {
   registry->RegisterDictionaryPref(kPrefName);
@@ -58,17 +66,40 @@ void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
     unsent_entries_.insert(histogram_name);
   }
 
-  // Update the persistent value.
+  // Schedule the persistent value update.
+  pending_value_updates_.insert(histogram_name);
+  if (!persist_timer_.IsRunning()) {
+    persist_timer_.Start(FROM_HERE, kPersistValuesDelay, this,
+                         &BraveP3ALogStore::PersistPendingValues);
+  }
+}
+
+void BraveP3ALogStore::PersistPendingValues() {
+  if (pending_value_updates_.empty()) {
+    return;
+  }
   DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({histogram_name, kLogValueKey},
-                  base::Value(base::NumberToString(value)));
-  update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  WritePendingValues(update.Get());
+}
+
+void BraveP3ALogStore::WritePendingValues(base::DictionaryValue* update) {
+  persist_timer_.Stop();
+  for (const std::string& histogram_name : pending_value_updates_) {
+    auto iter = log_.find(histogram_name);
+    DCHECK(iter != log_.end());
+    update->SetPath({histogram_name, kLogValueKey},
+                    base::Value(base::NumberToString(iter->second.value)));
+    update->SetPath({histogram_name, kLogSentKey},
+                    base::Value(iter->second.sent));
+  }
+  pending_value_updates_.clear();
 }
 
 void BraveP3ALogStore::RemoveValueIfExists(const std::string& histogram_name) {
   DCHECK(delegate_->IsActualMetric(histogram_name));
   log_.erase(histogram_name);
   unsent_entries_.erase(histogram_name);
+  pending_value_updates_.erase(histogram_name);
 
   // Update the persistent value.
   DictionaryPrefUpdate update(local_state_, kPrefName);
@@ -83,6 +114,7 @@ void BraveP3ALogStore::RemoveValueIfExists(const std::string& histogram_name) {
 void BraveP3ALogStore::ResetUploadStamps() {
   // Clear log entries flags.
   DictionaryPrefUpdate update(local_state_, kPrefName);
+  WritePendingValues(update.Get());
   for (auto& pair : log_) {
     if (pair.second.sent) {
       DCHECK(!pair.second.sent_timestamp.is_null());
@@ -167,8 +199,9 @@ void BraveP3ALogStore::DiscardStagedLog() {
   DCHECK(log_iter != log_.end());
   log_iter->second.MarkAsSent();
 
-  // Update the persistent value.
+  // Update the persistent value, along with any pending value updates.
   DictionaryPrefUpdate update(local_state_, kPrefName);
+  WritePendingValues(update.Get());
   update->SetPath({log_iter->first, kLogSentKey},
                   base::Value(log_iter->second.sent));
   update->SetPath({log_iter->first, kLogTimestampKey},
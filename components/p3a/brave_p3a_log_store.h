@@ -12,14 +12,22 @@
 #include "base/containers/flat_set.h"
 #include "base/strings/string_piece.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/metrics/log_store.h"
 
 class PrefService;
 class PrefRegistrySimple;
 
+namespace base {
+class DictionaryValue;
+}  // namespace base
+
 namespace brave {
 
-// Stores all given values in memory and persists in prefs on the fly.
+// Stores all given values in memory and persists them in prefs.
+// Value updates are coalesced and written to prefs in one go after a short
+// delay (or when the store is destroyed), while changes to the sent state are
+// written immediately.
 // All logs (not only unsent are persistent), and all logs could be loaded
 // using |LoadPersistedUnsentLogs()|. We should fix this at some point since
 // for now persisted entries never expire.
@@ -61,7 +69,7 @@ class BraveP3ALogStore : public metrics::LogStore {
   void MarkStagedLogAsSent() override;
 
   // |TrimAndPersistUnsentLogs| should not be used, since we persist everything
-  // on the fly.
+  // ourselves (see the class comment).
   void TrimAndPersistUnsentLogs() override;
   // Returns early if founds malformed persisted values.
   void LoadPersistedUnsentLogs() override;
@@ -84,6 +92,11 @@ class BraveP3ALogStore : public metrics::LogStore {
     base::Time sent_timestamp;  // At the moment only for debugging purposes.
   };
 
+  // Writes all coalesced value updates to prefs right away.
+  void PersistPendingValues();
+  // Writes the coalesced value updates using the given pref update.
+  void WritePendingValues(base::DictionaryValue* update);
+
   const Delegate* const delegate_ = nullptr;  // Weak.
   PrefService* const local_state_ = nullptr;
 
@@ -91,6 +104,10 @@ class BraveP3ALogStore : public metrics::LogStore {
   base::flat_map<std::string, LogEntry> log_;
   base::flat_set<std::string> unsent_entries_;
 
+  // Entries whose value changed since the last pref write.
+  base::flat_set<std::string> pending_value_updates_;
+  base::OneShotTimer persist_timer_;
+
   std::string staged_entry_key_;
   std::string staged_log_;
 
@@ -0,0 +1,119 @@
+// Copyright (c) 2020 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/p3a/brave_p3a_log_store.h"
+
+#include <memory>
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/test/task_environment.h"
+#include "base/values.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BraveP3ALogStoreTest.*
+
+namespace brave {
+
+namespace {
+
+constexpr char kPrefName[] = "p3a.logs";
+
+class TestDelegate : public BraveP3ALogStore::Delegate {
+ public:
+  std::string Serialize(base::StringPiece histogram_name,
+                        uint64_t value) const override {
+    return histogram_name.as_string() + ":" + base::NumberToString(value);
+  }
+  bool IsActualMetric(base::StringPiece histogram_name) const override {
+    return true;
+  }
+};
+
+}  // namespace
+
+class BraveP3ALogStoreTest : public testing::Test {
+ public:
+  BraveP3ALogStoreTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME) {
+    BraveP3ALogStore::RegisterPrefs(local_state_.registry());
+    log_store_ = std::make_unique<BraveP3ALogStore>(&delegate_, &local_state_);
+    log_store_->LoadPersistedUnsentLogs();
+  }
+
+  const base::Value* GetPersistedEntry(const std::string& histogram_name) {
+    return local_state_.GetDictionary(kPrefName)->FindKey(histogram_name);
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  TestingPrefServiceSimple local_state_;
+  TestDelegate delegate_;
+  std::unique_ptr<BraveP3ALogStore> log_store_;
+};
+
+TEST_F(BraveP3ALogStoreTest, ValueUpdatesAreCoalesced) {
+  log_store_->UpdateValue("Brave.P3A.A", 1);
+  log_store_->UpdateValue("Brave.P3A.A", 2);
+  log_store_->UpdateValue("Brave.P3A.B", 3);
+  EXPECT_TRUE(log_store_->has_unsent_logs());
+  EXPECT_EQ(nullptr, GetPersistedEntry("Brave.P3A.A"));
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+  const base::Value* entry = GetPersistedEntry("Brave.P3A.A");
+  ASSERT_TRUE(entry);
+  EXPECT_EQ("2", *entry->FindStringKey("value"));
+  EXPECT_FALSE(*entry->FindBoolKey("sent"));
+  entry = GetPersistedEntry("Brave.P3A.B");
+  ASSERT_TRUE(entry);
+  EXPECT_EQ("3", *entry->FindStringKey("value"));
+}
+
+TEST_F(BraveP3ALogStoreTest, SentStateIsPersistedImmediately) {
+  log_store_->UpdateValue("Brave.P3A.A", 1);
+  log_store_->StageNextLog();
+  EXPECT_EQ("Brave.P3A.A:1", log_store_->staged_log());
+  log_store_->DiscardStagedLog();
+  EXPECT_FALSE(log_store_->has_unsent_logs());
+
+  // The pending value is written along with the sent flag.
+  const base::Value* entry = GetPersistedEntry("Brave.P3A.A");
+  ASSERT_TRUE(entry);
+  EXPECT_EQ("1", *entry->FindStringKey("value"));
+  EXPECT_TRUE(*entry->FindBoolKey("sent"));
+}
+
+TEST_F(BraveP3ALogStoreTest, RemovedValueIsNotPersisted) {
+  log_store_->UpdateValue("Brave.P3A.A", 1);
+  log_store_->RemoveValueIfExists("Brave.P3A.A");
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+  EXPECT_EQ(nullptr, GetPersistedEntry("Brave.P3A.A"));
+  EXPECT_FALSE(log_store_->has_unsent_logs());
+}
+
+TEST_F(BraveP3ALogStoreTest, PersistedValuesAreLoaded) {
+  log_store_->UpdateValue("Brave.P3A.A", 5);
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+
+  BraveP3ALogStore other_log_store(&delegate_, &local_state_);
+  other_log_store.LoadPersistedUnsentLogs();
+  ASSERT_TRUE(other_log_store.has_unsent_logs());
+  other_log_store.StageNextLog();
+  EXPECT_EQ("Brave.P3A.A:5", other_log_store.staged_log());
+}
+
+TEST_F(BraveP3ALogStoreTest, PendingValuesArePersistedOnDestruction) {
+  log_store_->UpdateValue("Brave.P3A.A", 7);
+  EXPECT_EQ(nullptr, GetPersistedEntry("Brave.P3A.A"));
+
+  log_store_.reset();
+  const base::Value* entry = GetPersistedEntry("Brave.P3A.A");
+  ASSERT_TRUE(entry);
+  EXPECT_EQ("7", *entry->FindStringKey("value"));
+  EXPECT_FALSE(*entry->FindBoolKey("sent"));
+}
+
+}  // namespace brave
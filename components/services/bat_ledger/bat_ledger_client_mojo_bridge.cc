@@ -11,16 +11,33 @@
 #include <vector>
 
 #include "base/logging.h"
+#include "base/task/post_task.h"
+#include "base/task/thread_pool.h"
+#include "base/task_runner_util.h"
 #include "brave/base/containers/utils.h"
 
 namespace bat_ledger {
 
 BatLedgerClientMojoBridge::BatLedgerClientMojoBridge(
-      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info) {
+      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info,
+      const base::FilePath& database_path) {
   bat_ledger_client_.Bind(std::move(client_info));
+
+  if (!database_path.empty()) {
+    database_task_runner_ = base::CreateSequencedTaskRunner(
+        {base::ThreadPool(), base::MayBlock(),
+         base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::BLOCK_SHUTDOWN});
+    ledger_database_.reset(
+        ledger::LedgerDatabase::CreateInstance(database_path));
+  }
 }
 
-BatLedgerClientMojoBridge::~BatLedgerClientMojoBridge() = default;
+BatLedgerClientMojoBridge::~BatLedgerClientMojoBridge() {
+  // Pending transactions still hold a pointer to the database
+  if (ledger_database_)
+    database_task_runner_->DeleteSoon(FROM_HERE, ledger_database_.release());
+}
 
 void OnLoadURL(
     const ledger::client::LoadURLCallback& callback,
@@ -324,14 +341,41 @@ void OnRunDBTransaction(
   callback(std::move(response));
 }
 
+ledger::type::DBCommandResponsePtr RunDBTransactionOnDatabaseTaskRunner(
+    ledger::type::DBTransactionPtr transaction,
+    ledger::LedgerDatabase* database) {
+  auto response = ledger::type::DBCommandResponse::New();
+  database->RunTransaction(std::move(transaction), response.get());
+  return response;
+}
+
 void BatLedgerClientMojoBridge::RunDBTransaction(
     ledger::type::DBTransactionPtr transaction,
     ledger::client::RunDBTransactionCallback callback) {
+  if (ledger_database_) {
+    base::PostTaskAndReplyWithResult(
+        database_task_runner_.get(),
+        FROM_HERE,
+        base::BindOnce(&RunDBTransactionOnDatabaseTaskRunner,
+            std::move(transaction),
+            base::Unretained(ledger_database_.get())),
+        base::BindOnce(&BatLedgerClientMojoBridge::OnRunDBTransaction,
+            AsWeakPtr(),
+            std::move(callback)));
+    return;
+  }
+
   bat_ledger_client_->RunDBTransaction(
       std::move(transaction),
       base::BindOnce(&OnRunDBTransaction, std::move(callback)));
 }
 
+void BatLedgerClientMojoBridge::OnRunDBTransaction(
+    ledger::client::RunDBTransactionCallback callback,
+    ledger::type::DBCommandResponsePtr response) {
+  callback(std::move(response));
+}
+
 void OnGetCreateScript(
     const ledger::client::GetCreateScriptCallback& callback,
     const std::string& script,
@@ -11,8 +11,12 @@
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
 #include "bat/ledger/ledger_client.h"
+#include "bat/ledger/ledger_database.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/bindings/pending_associated_remote.h"
@@ -23,8 +27,11 @@ class BatLedgerClientMojoBridge :
     public ledger::LedgerClient,
     public base::SupportsWeakPtr<BatLedgerClientMojoBridge>{
  public:
+  // When |database_path| is not empty the database is opened and its
+  // transactions are run in this process instead of in the browser.
   BatLedgerClientMojoBridge(
-      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info);
+      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info,
+      const base::FilePath& database_path);
   ~BatLedgerClientMojoBridge() override;
 
   BatLedgerClientMojoBridge(const BatLedgerClientMojoBridge&) = delete;
@@ -127,7 +134,13 @@ class BatLedgerClientMojoBridge :
  private:
   bool Connected() const;
 
+  void OnRunDBTransaction(
+      ledger::client::RunDBTransactionCallback callback,
+      ledger::type::DBCommandResponsePtr response);
+
   mojo::AssociatedRemote<mojom::BatLedgerClient> bat_ledger_client_;
+  scoped_refptr<base::SequencedTaskRunner> database_task_runner_;
+  std::unique_ptr<ledger::LedgerDatabase> ledger_database_;
 };
 
 }  // namespace bat_ledger
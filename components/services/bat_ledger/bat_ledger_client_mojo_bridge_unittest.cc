@@ -0,0 +1,90 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ledger/bat_ledger_client_mojo_bridge.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BatLedgerClientMojoBridgeTest.*
+
+namespace bat_ledger {
+
+class BatLedgerClientMojoBridgeTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    bridge_ = std::make_unique<BatLedgerClientMojoBridge>(
+        mojo::PendingAssociatedRemote<mojom::BatLedgerClient>(),
+        temp_dir_.GetPath().AppendASCII("publisher_info_db"));
+  }
+
+  void TearDown() override {
+    // The database is closed on its own sequence
+    bridge_.reset();
+    task_environment_.RunUntilIdle();
+  }
+
+  ledger::type::DBCommandResponsePtr RunDBTransaction(
+      ledger::type::DBTransactionPtr transaction) {
+    ledger::type::DBCommandResponsePtr result;
+    base::RunLoop run_loop;
+    bridge_->RunDBTransaction(
+        std::move(transaction),
+        [&result, &run_loop](ledger::type::DBCommandResponsePtr response) {
+          result = std::move(response);
+          run_loop.Quit();
+        });
+    run_loop.Run();
+    return result;
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<BatLedgerClientMojoBridge> bridge_;
+};
+
+TEST_F(BatLedgerClientMojoBridgeTest, RunDBTransactionInProcess) {
+  auto transaction = ledger::type::DBTransaction::New();
+  auto command = ledger::type::DBCommand::New();
+  command->type = ledger::type::DBCommand::Type::EXECUTE;
+  command->command = "CREATE TABLE test (value INTEGER)";
+  transaction->commands.push_back(std::move(command));
+
+  command = ledger::type::DBCommand::New();
+  command->type = ledger::type::DBCommand::Type::EXECUTE;
+  command->command = "INSERT INTO test (value) VALUES (7)";
+  transaction->commands.push_back(std::move(command));
+
+  auto response = RunDBTransaction(std::move(transaction));
+  ASSERT_TRUE(response);
+  EXPECT_EQ(response->status,
+            ledger::type::DBCommandResponse::Status::RESPONSE_OK);
+
+  transaction = ledger::type::DBTransaction::New();
+  command = ledger::type::DBCommand::New();
+  command->type = ledger::type::DBCommand::Type::READ;
+  command->command = "SELECT value FROM test";
+  command->record_bindings = {
+      ledger::type::DBCommand::RecordBindingType::INT64_TYPE};
+  transaction->commands.push_back(std::move(command));
+
+  response = RunDBTransaction(std::move(transaction));
+  ASSERT_TRUE(response);
+  EXPECT_EQ(response->status,
+            ledger::type::DBCommandResponse::Status::RESPONSE_OK);
+  ASSERT_TRUE(response->result && response->result->is_records());
+  const auto& records = response->result->get_records();
+  ASSERT_EQ(records->row_count, 1u);
+  ASSERT_EQ(records->values->int_values.size(), 1u);
+  EXPECT_EQ(records->values->int_values[0], 7);
+}
+
+}  // namespace bat_ledger
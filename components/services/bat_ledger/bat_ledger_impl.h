@@ -14,6 +14,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "bat/ledger/ledger.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
@@ -26,8 +27,11 @@ class BatLedgerImpl :
     public mojom::BatLedger,
     public base::SupportsWeakPtr<BatLedgerImpl> {
  public:
-  explicit BatLedgerImpl(
-      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info);
+  // Database transactions are run in this process on the database at
+  // |database_path| if not empty, or by the browser otherwise.
+  BatLedgerImpl(
+      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info,
+      const base::FilePath& database_path);
   ~BatLedgerImpl() override;
 
   BatLedgerImpl(const BatLedgerImpl&) = delete;
@@ -31,7 +31,7 @@ void BatLedgerServiceImpl::Create(
     mojo::PendingAssociatedReceiver<mojom::BatLedger> bat_ledger,
     CreateCallback callback) {
   associated_receivers_.Add(
-      std::make_unique<BatLedgerImpl>(std::move(client_info)),
+      std::make_unique<BatLedgerImpl>(std::move(client_info), database_path_),
       std::move(bat_ledger));
   initialized_ = true;
   std::move(callback).Run();
@@ -62,6 +62,11 @@ void BatLedgerServiceImpl::SetTesting() {
   ledger::is_testing = true;
 }
 
+void BatLedgerServiceImpl::SetDatabasePath(const base::FilePath& path) {
+  DCHECK(!initialized_);
+  database_path_ = path;
+}
+
 void BatLedgerServiceImpl::GetEnvironment(GetEnvironmentCallback callback) {
   std::move(callback).Run(ledger::_environment);
 }
@@ -69,7 +69,8 @@ void SpeedreaderRewriterService::OnWhitelistReady(const base::FilePath& path) {
   base::PostTaskAndReplyWithResult(
       FROM_HERE, {base::ThreadPool(), base::MayBlock()},
       base::BindOnce(
-          &brave_component_updater::LoadDATFileData<speedreader::SpeedReader>,
+          &brave_component_updater::LoadMappedDATFileData<
+              speedreader::SpeedReader>,
           path),
       base::BindOnce(&SpeedreaderRewriterService::OnLoadDATFileData,
                      weak_factory_.GetWeakPtr()));
@@ -102,10 +103,10 @@ void SpeedreaderRewriterService::OnLoadStylesheet(std::string stylesheet) {
 }
 
 void SpeedreaderRewriterService::OnLoadDATFileData(
-    GetDATFileDataResult result) {
+    std::unique_ptr<speedreader::SpeedReader> result) {
   VLOG(2) << "Speedreader loaded from DAT file";
-  if (result.first)
-    speedreader_ = std::move(result.first);
+  if (result)
+    speedreader_ = std::move(result);
 }
 
 }  // namespace speedreader
@@ -47,10 +47,7 @@ class SpeedreaderRewriterService : public SpeedreaderComponent::Observer {
   const std::string& GetContentStylesheet();
 
  private:
-  using GetDATFileDataResult =
-      brave_component_updater::LoadDATFileDataResult<speedreader::SpeedReader>;
-
-  void OnLoadDATFileData(GetDATFileDataResult result);
+  void OnLoadDATFileData(std::unique_ptr<speedreader::SpeedReader> result);
   void OnLoadStylesheet(std::string stylesheet);
 
   std::string content_stylesheet_;
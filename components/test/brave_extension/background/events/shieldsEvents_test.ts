@@ -4,7 +4,7 @@
 
 import '../../../../brave_extension/extension/brave_extension/background/events/shieldsEvents'
 import actions from '../../../../brave_extension/extension/brave_extension/background/actions/shieldsPanelActions'
-import { blockedResource } from '../../../testData'
+import { blockedResources } from '../../../testData'
 
 describe('shieldsEvents events', () => {
   describe('chrome.braveShields.onBlocked listener', () => {
@@ -15,13 +15,23 @@ describe('shieldsEvents events', () => {
     afterEach(() => {
       spy.mockRestore()
     })
-    it('forward details to actions.resourceBlocked', (cb) => {
+    it('forwards each subresource to actions.resourceBlocked', (cb) => {
       chrome.braveShields.onBlocked.addListener((details) => {
-        expect(details).toBe(blockedResource)
-        expect(spy).toBeCalledWith(details)
+        expect(details).toBe(blockedResources)
+        expect(spy).toHaveBeenCalledTimes(2)
+        expect(spy).toBeCalledWith({
+          blockType: 'ads',
+          tabId: 2,
+          subresource: 'https://www.brave.com/test'
+        })
+        expect(spy).toBeCalledWith({
+          blockType: 'ads',
+          tabId: 2,
+          subresource: 'https://www.brave.com/test2'
+        })
         cb()
       })
-      chrome.braveShields.onBlocked.emit(blockedResource)
+      chrome.braveShields.onBlocked.emit(blockedResources)
     })
   })
 })
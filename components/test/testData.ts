@@ -9,7 +9,7 @@ import { defaultState as adblockData } from '../../components/brave_adblock_ui/s
 
 // Types
 import { Tab } from '../brave_extension/extension/brave_extension/types/state/shieldsPannelState'
-import { BlockDetails } from '../brave_extension/extension/brave_extension/types/actions/shieldsPanelActions'
+import { BlockedBatchDetails } from '../brave_extension/extension/brave_extension/types/actions/shieldsPanelActions'
 
 // Helpers
 import * as deepFreeze from 'deep-freeze-node'
@@ -96,10 +96,10 @@ export const tabs: Tabs = {
 
 export const activeTabData = tabs[2]
 
-export const blockedResource: BlockDetails = {
+export const blockedResources: BlockedBatchDetails = {
   blockType: 'ads',
   tabId: 2,
-  subresource: 'https://www.brave.com/test'
+  subresources: ['https://www.brave.com/test', 'https://www.brave.com/test2']
 }
 
 // see: https://developer.chrome.com/extensions/events
@@ -8,10 +8,13 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <functional>
 #include <memory>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
@@ -28,20 +31,29 @@ namespace net {
 // Used to cache <username, password> of proxies
 class TorProxyMap {
  public:
-  TorProxyMap();
+  explicit TorProxyMap(ProxyResolutionService* service);
   ~TorProxyMap();
   std::string Get(const std::string& key);
   void Erase(const std::string& key);
   void MaybeExpire(const std::string& key, const base::Time& timestamp);
+  // Clear up to kMaxExpiredEntriesPerBatch expired entries in the queue from
+  // the map and reschedule the timer for the next batch.
+  void ClearExpiredEntries();
   size_t size() const;
 
  private:
   // Generate a new base 64-encoded 128 bit random tag
   static std::string GenerateNewPassword();
-  // Clear expired entries in the queue from the map.
-  void ClearExpiredEntries();
-  std::map<std::string, std::pair<std::string, base::Time>> map_;
-  std::priority_queue<std::pair<base::Time, std::string>> queue_;
+  // Schedule |timer_| for when the oldest entry in the queue expires.
+  void ScheduleExpiry();
+
+  ProxyResolutionService* service_;
+  std::unordered_map<std::string, std::pair<std::string, base::Time>> map_;
+  // Min-heap, oldest entry on top.
+  std::priority_queue<std::pair<base::Time, std::string>,
+                      std::vector<std::pair<base::Time, std::string>>,
+                      std::greater<std::pair<base::Time, std::string>>>
+      queue_;
   base::OneShotTimer timer_;
   DISALLOW_COPY_AND_ASSIGN(TorProxyMap);
 };
@@ -68,30 +80,31 @@ constexpr NetworkTrafficAnnotationTag kTorProxyTrafficAnnotation =
         policy_exception_justification: "Not implemented."
       })");
 
-static base::NoDestructor<std::map<
-    ProxyResolutionService*, TorProxyMap>> tor_proxy_map_;
+static base::NoDestructor<std::unordered_map<
+    ProxyResolutionService*, std::unique_ptr<TorProxyMap>>> tor_proxy_map_;
 
 TorProxyMap* GetTorProxyMap(
     ProxyResolutionService* service) {
-  return &(tor_proxy_map_.get()->operator[](service));
+  std::unique_ptr<TorProxyMap>& map = (*tor_proxy_map_)[service];
+  if (!map)
+    map = std::make_unique<TorProxyMap>(service);
+  return map.get();
 }
 
-bool IsTorProxyConfig(const ProxyConfigWithAnnotation& config) {
-  auto tag = config.traffic_annotation();
-  // iterate through tor_proxy_map_ and remove any entries with
-  // empty TorProxyMap (all entries have expired)
-  // we do this here because the other methods are only called when
-  // IsTorProxy is true so the last entry will never be deleted
-  for (auto it = tor_proxy_map_.get()->cbegin();
-       it != tor_proxy_map_.get()->cend(); ) {
-    if (it->second.size() == 0) {
-      tor_proxy_map_->erase(it++);
-    } else {
-      ++it;
-    }
-  }
+// Runs from the expiry timer of the TorProxyMap for |service|, and drops the
+// TorProxyMap once all of its entries have expired so that classifying a
+// request never has to look for empty maps.
+void ClearExpiredTorProxyEntries(ProxyResolutionService* service) {
+  auto it = tor_proxy_map_->find(service);
+  if (it == tor_proxy_map_->end())
+    return;
+  it->second->ClearExpiredEntries();
+  if (it->second->size() == 0)
+    tor_proxy_map_->erase(it);
+}
 
-  return tag.unique_id_hash_code ==
+bool IsTorProxyConfig(const ProxyConfigWithAnnotation& config) {
+  return config.traffic_annotation().unique_id_hash_code ==
          kTorProxyTrafficAnnotation.unique_id_hash_code;
 }
 
@@ -100,6 +113,9 @@ bool IsTorProxyConfig(const ProxyConfigWithAnnotation& config) {
 const int kTorPasswordLength = 16;
 // Default tor circuit life time is 10 minutes
 constexpr base::TimeDelta kTenMins = base::TimeDelta::FromMinutes(10);
+// Upper bound on the number of queue entries handled by one timer run, so
+// that a burst of expiries doesn't stall the network thread.
+const size_t kMaxExpiredEntriesPerBatch = 64;
 
 ProxyConfigServiceTor::ProxyConfigServiceTor() {}
 
@@ -228,7 +244,9 @@ ProxyConfigServiceTor::GetLatestProxyConfig(
   return CONFIG_VALID;
 }
 
-TorProxyMap::TorProxyMap() = default;
+TorProxyMap::TorProxyMap(ProxyResolutionService* service)
+    : service_(service) {}
+
 TorProxyMap::~TorProxyMap() {
   timer_.Stop();
 }
@@ -242,27 +260,26 @@ std::string TorProxyMap::GenerateNewPassword() {
 
 std::string TorProxyMap::Get(
     const std::string& username) {
-  // Clear any expired entries, in case this one has expired.
-  ClearExpiredEntries();
+  const base::Time now = base::Time::Now();
 
-  // Check for an entry for this username.
+  // Check for an entry for this username. Expired entries are normally
+  // removed by the timer, but it may not have caught up yet.
   auto found = map_.find(username);
-  if (found != map_.end())
-    return found->second.first;
+  if (found != map_.end()) {
+    if (found->second.second > now - kTenMins)
+      return found->second.first;
+    map_.erase(found);
+  }
 
   // No entry yet.  Check our watch and create one.
-  const base::Time now = base::Time::Now();
   const std::string password = GenerateNewPassword();
   map_.emplace(username, std::make_pair(password, now));
   queue_.emplace(now, username);
 
-  // Reschedule the timer for ten minutes from now so that this entry
-  // won't last more than about ten minutes even if the user stops
-  // using Tor for a while.
-  // TODO(bridiver) - the timer should be in the ProxyConfigServiceTor class
-  timer_.Stop();
-  timer_.Start(FROM_HERE, kTenMins, this,
-               &TorProxyMap::ClearExpiredEntries);
+  // Make sure this entry won't last more than about ten minutes even if the
+  // user stops using Tor for a while.
+  if (!timer_.IsRunning())
+    ScheduleExpiry();
 
   return password;
 }
@@ -292,7 +309,8 @@ void TorProxyMap::MaybeExpire(
 
 void TorProxyMap::ClearExpiredEntries() {
   const base::Time cutoff = base::Time::Now() - kTenMins;
-  for (; !queue_.empty(); queue_.pop()) {
+  for (size_t i = 0; i < kMaxExpiredEntriesPerBatch && !queue_.empty();
+       ++i, queue_.pop()) {
     // Check the timestamp.  If it's not older than the cutoff, stop.
     const std::pair<base::Time, std::string>* entry = &queue_.top();
     const base::Time timestamp = entry->first;
@@ -311,10 +329,22 @@ void TorProxyMap::ClearExpiredEntries() {
       // the queue in order to last the full ten minutes.
       const base::Time map_timestamp = found->second.second;
       if (map_timestamp == timestamp) {
-        map_.erase(username);
+        map_.erase(found);
       }
     }
   }
+  ScheduleExpiry();
+}
+
+void TorProxyMap::ScheduleExpiry() {
+  timer_.Stop();
+  if (queue_.empty())
+    return;
+  // If the last batch stopped early this fires right away.
+  const base::TimeDelta delay = std::max(
+      queue_.top().first + kTenMins - base::Time::Now(), base::TimeDelta());
+  timer_.Start(FROM_HERE, delay,
+               base::BindOnce(&ClearExpiredTorProxyEntries, service_));
 }
 
 }  // namespace net
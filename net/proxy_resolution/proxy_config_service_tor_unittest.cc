@@ -22,7 +22,9 @@ namespace net {
 
 class ProxyConfigServiceTorTest : public TestWithTaskEnvironment {
  public:
-  ProxyConfigServiceTorTest() {}
+  ProxyConfigServiceTorTest()
+      : TestWithTaskEnvironment(
+            base::test::TaskEnvironment::TimeSource::MOCK_TIME) {}
   ~ProxyConfigServiceTorTest() override {}
 
  private:
@@ -211,4 +213,42 @@ TEST_F(ProxyConfigServiceTorTest, SetProxyAuthorization) {
   EXPECT_EQ(host_port_pair.port(), 5566);
 }
 
+TEST_F(ProxyConfigServiceTorTest, CircuitIsolationExpires) {
+  const std::string proxy_uri("socks5://127.0.0.1:5566");
+  const GURL site_url("https://check.torproject.org/");
+
+  auto config_service =
+      ConfiguredProxyResolutionService::CreateSystemProxyConfigService(
+          base::ThreadTaskRunnerHandle::Get());
+  auto* service = new ConfiguredProxyResolutionService(
+      std::move(config_service),
+      std::make_unique<MockAsyncProxyResolverFactory>(false), nullptr,
+      /*quick_check_enabled=*/true);
+
+  ProxyConfigServiceTor proxy_config_service(proxy_uri);
+  ProxyConfigWithAnnotation config;
+  proxy_config_service.GetLatestProxyConfig(&config);
+
+  ProxyInfo info;
+  ProxyConfigServiceTor::SetProxyAuthorization(
+      config, site_url, service, &info);
+  const std::string password =
+      info.proxy_server().host_port_pair().password();
+  EXPECT_FALSE(password.empty());
+
+  // Still the same circuit before the timeout.
+  FastForwardBy(base::TimeDelta::FromMinutes(9));
+  ProxyInfo info2;
+  ProxyConfigServiceTor::SetProxyAuthorization(
+      config, site_url, service, &info2);
+  EXPECT_EQ(info2.proxy_server().host_port_pair().password(), password);
+
+  // The expiry timer drops the entry, so a new circuit is used afterwards.
+  FastForwardBy(base::TimeDelta::FromMinutes(2));
+  ProxyInfo info3;
+  ProxyConfigServiceTor::SetProxyAuthorization(
+      config, site_url, service, &info3);
+  EXPECT_NE(info3.proxy_server().host_port_pair().password(), password);
+}
+
 }  // namespace net
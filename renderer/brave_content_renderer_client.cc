@@ -4,6 +4,11 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "brave/renderer/brave_content_renderer_client.h"
+
+#include "base/feature_list.h"
+#include "brave/components/brave_shields/common/features.h"
+#include "brave/components/brave_shields/renderer/cosmetic_filters_agent.h"
+#include "build/build_config.h"
 #include "third_party/blink/public/platform/web_runtime_features.h"
 
 BraveContentRendererClient::BraveContentRendererClient()
@@ -16,4 +21,18 @@ SetRuntimeFeaturesDefaultsBeforeBlinkInitialization() {
 
   blink::WebRuntimeFeatures::EnableSharedArrayBuffer(false);
 }
+
+void BraveContentRendererClient::RenderFrameCreated(
+    content::RenderFrame* render_frame) {
+  ChromeContentRendererClient::RenderFrameCreated(render_frame);
+
+#if !defined(OS_ANDROID)
+  // Android has no extension content script to handle DOM mutations.
+  if (base::FeatureList::IsEnabled(
+          brave_shields::features::kBraveNativeCosmeticFiltering)) {
+    // Owns itself and is deleted along with |render_frame|.
+    new brave_shields::CosmeticFiltersAgent(render_frame);
+  }
+#endif
+}
 BraveContentRendererClient::~BraveContentRendererClient() = default;
@@ -12,6 +12,7 @@ class BraveContentRendererClient : public ChromeContentRendererClient {
   BraveContentRendererClient();
   ~BraveContentRendererClient() override;
   void SetRuntimeFeaturesDefaultsBeforeBlinkInitialization() override;
+  void RenderFrameCreated(content::RenderFrame* render_frame) override;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(BraveContentRendererClient);